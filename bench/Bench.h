@@ -0,0 +1,122 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Minimal benchmark harness: each case is calibrated so one sample runs for at
+// least minSampleMs, then timed over a fixed number of samples. Reporting the
+// median (and min) per iteration keeps results stable across runs.
+namespace bench {
+
+struct Result {
+    std::string name;
+    int samples = 0;
+    long long itersPerSample = 0;
+    double minNs = 0, medianNs = 0, meanNs = 0, p90Ns = 0, stddevNs = 0;
+    double items = 0; // work items per iteration (cells, actors...), 0 = n/a
+    std::string skipped; // why the case could not run; empty when it ran
+};
+
+struct Options {
+    double minSampleMs = 20.0;
+    int samples = 15;
+    std::string filter;
+};
+
+inline double nowNs() {
+    using namespace std::chrono;
+    return static_cast<double>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+template <class F>
+bool run(const Options& opt, const std::string& name, double items, F&& fn, std::vector<Result>& out) {
+    if (!opt.filter.empty() && name.find(opt.filter) == std::string::npos) return false;
+
+    // warm up and calibrate: double the batch until it takes minSampleMs
+    long long iters = 1;
+    for (;;) {
+        double t0 = nowNs();
+        for (long long i = 0; i < iters; ++i) fn();
+        double ms = (nowNs() - t0) / 1e6;
+        if (ms >= opt.minSampleMs || iters >= (1LL << 30)) break;
+        iters *= (ms < opt.minSampleMs / 16.0) ? 8 : 2;
+    }
+
+    std::vector<double> perIter;
+    perIter.reserve(static_cast<size_t>(opt.samples));
+    for (int s = 0; s < opt.samples; ++s) {
+        double t0 = nowNs();
+        for (long long i = 0; i < iters; ++i) fn();
+        perIter.push_back((nowNs() - t0) / static_cast<double>(iters));
+    }
+    std::sort(perIter.begin(), perIter.end());
+
+    Result r;
+    r.name = name;
+    r.samples = opt.samples;
+    r.itersPerSample = iters;
+    r.items = items;
+    r.minNs = perIter.front();
+    r.medianNs = perIter[perIter.size() / 2];
+    r.p90Ns = perIter[std::min(perIter.size() - 1, perIter.size() * 9 / 10)];
+    double sum = 0;
+    for (double v : perIter) sum += v;
+    r.meanNs = sum / perIter.size();
+    double var = 0;
+    for (double v : perIter) var += (v - r.meanNs) * (v - r.meanNs);
+    r.stddevNs = std::sqrt(var / perIter.size());
+    out.push_back(r);
+
+    std::fprintf(stderr, "%-36s %12.0f ns/iter (min %.0f, p90 %.0f)\n", name.c_str(), r.medianNs, r.minNs, r.p90Ns);
+    return true;
+}
+
+// Record a case that could not run (missing asset...), so it shows up in the
+// report instead of silently dropping out of it
+inline void skip(const Options& opt, const std::string& name, const std::string& reason, std::vector<Result>& out) {
+    if (!opt.filter.empty() && name.find(opt.filter) == std::string::npos) return;
+    Result r;
+    r.name = name;
+    r.skipped = reason;
+    out.push_back(r);
+    std::fprintf(stderr, "%-36s SKIPPED: %s\n", name.c_str(), reason.c_str());
+}
+
+inline std::string jsonEscape(const std::string& s) {
+    std::string o;
+    for (char c : s) {
+        if (c == '"' || c == '\\') o += '\\';
+        if (static_cast<unsigned char>(c) < 0x20) continue;
+        o += c;
+    }
+    return o;
+}
+
+// {"context": {...}, "benchmarks": [...]} -- field names are stable across versions
+inline void writeJson(FILE* f, const std::vector<std::pair<std::string, std::string>>& context, const std::vector<Result>& results) {
+    std::fprintf(f, "{\n  \"schema\": 1,\n  \"context\": {");
+    for (size_t i = 0; i < context.size(); ++i) {
+        std::fprintf(f, "%s\n    \"%s\": \"%s\"", i ? "," : "", jsonEscape(context[i].first).c_str(), jsonEscape(context[i].second).c_str());
+    }
+    std::fprintf(f, "\n  },\n  \"benchmarks\": [");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        if (!r.skipped.empty()) {
+            std::fprintf(f, "%s\n    {\"name\": \"%s\", \"skipped\": \"%s\"}", i ? "," : "",
+                         jsonEscape(r.name).c_str(), jsonEscape(r.skipped).c_str());
+            continue;
+        }
+        std::fprintf(f, "%s\n    {\"name\": \"%s\", \"samples\": %d, \"iterations\": %lld, \"median_ns\": %.1f, "
+                        "\"min_ns\": %.1f, \"mean_ns\": %.1f, \"p90_ns\": %.1f, \"stddev_ns\": %.1f",
+                     i ? "," : "", jsonEscape(r.name).c_str(), r.samples, r.itersPerSample, r.medianNs, r.minNs, r.meanNs,
+                     r.p90Ns, r.stddevNs);
+        if (r.items > 0) std::fprintf(f, ", \"items\": %.0f, \"ns_per_item\": %.3f", r.items, r.medianNs / r.items);
+        std::fprintf(f, "}");
+    }
+    std::fprintf(f, "\n  ]\n}\n");
+}
+
+}
@@ -0,0 +1,352 @@
+// projekcik_bench: headless benchmarks (dummy video driver + software
+// renderer, no GPU or display needed). Results go to stdout as JSON.
+//
+//   projekcik_bench [--assets DIR] [--out FILE] [--filter TEXT] [--quick]
+//
+// Without --assets, assets come from assets.pak or assets/ next to the binary.
+// Cases that can't run (missing asset...) are listed as "skipped" in the JSON
+// and make the run exit with status 3.
+#include "Bench.h"
+#include "AssetArchive.h"
+#include "Background.h"
+#include "Collision.h"
+#include "Level.h"
+#include "LevelEditor.h"
+#include "Player.h"
+#include "Simulation.h"
+#include "TextRenderer.h"
+#include "Texture.h"
+#include "TileRenderer.h"
+#include <SDL.h>
+#include <SDL_image.h>
+#include <SDL_ttf.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+const int kViewW = 512; // the game's logical resolution
+const int kViewH = 288;
+const int kCell = 32;
+
+// Texture loads log a "DBG:" line on every call, which would flood the timed
+// loops; drop just those and keep failures and warnings visible
+SDL_LogOutputFunction defaultLog = nullptr;
+void* defaultLogData = nullptr;
+
+void benchLog(void* userdata, int category, SDL_LogPriority priority, const char* message) {
+    if (std::strncmp(message, "DBG:", 4) == 0) return;
+    if (defaultLog) defaultLog(userdata, category, priority, message);
+}
+
+// Level with a ground row; density = chance of a random non-empty tile above it
+void fillLevel(Level& level, int rows, int cols, double density, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    level.grid.assignRows(rows, cols, [&](int r, ChunkedTileMap::Tile* out) {
+        for (int c = 0; c < cols; ++c) {
+            if (r == rows - 2) out[c] = TILE_SOLID;
+            else if (r < rows - 2 && chance(rng) < density) out[c] = static_cast<ChunkedTileMap::Tile>(1 + rng() % 3);
+            else out[c] = TILE_EMPTY;
+        }
+    });
+}
+
+void benchCollision(const bench::Options& opt, std::vector<bench::Result>& out) {
+    for (double density : { 0.02, 0.5 }) {
+        const char* tag = density < 0.1 ? "sparse" : "dense";
+        Level level;
+        fillLevel(level, 20, 4000, density, 1);
+
+        // fixed set of probe boxes so every run does the same work
+        std::mt19937 rng(2);
+        std::vector<Player> probes(1024);
+        for (Player& p : probes) {
+            p.width = 32;
+            p.height = 48;
+            p.x = static_cast<float>(rng() % (4000 * kCell - 64));
+            p.y = static_cast<float>(48 + rng() % (18 * kCell - 48));
+            p.invulnTimer = 1e9f; // no damage bookkeeping noise
+        }
+        std::vector<Player> work = probes;
+        size_t next = 0;
+
+        // pickups are consumed as they're hit, so reset the probe state but not the level:
+        // after warm-up the measured work is the steady-state push-out
+        bench::run(opt, std::string("collision/resolve_") + tag, 1, [&] {
+            Player& p = work[next];
+            p = probes[next];
+            resolvePlayerCollisions(p, level, kCell, kCell);
+            next = (next + 1) & 1023;
+        }, out);
+
+        bench::run(opt, std::string("collision/swept_") + tag, 1, [&] {
+            Player& p = work[next];
+            p = probes[next];
+            float fromX = p.x - 200.0f, fromY = p.y - 120.0f; // a large step into the box
+            movePlayerSwept(p, level, fromX, fromY, kCell, kCell);
+            next = (next + 1) & 1023;
+        }, out);
+
+        // large boxes: broadphase should keep this close to the small-box cost on sparse grids
+        bench::run(opt, std::string("collision/resolve_big_box_") + tag, 1, [&] {
+            Player& p = work[next];
+            p = probes[next];
+            p.width = 320;
+            p.height = 320;
+            p.y = std::max(p.y, 320.0f);
+            resolvePlayerCollisions(p, level, kCell, kCell);
+            next = (next + 1) & 1023;
+        }, out);
+    }
+
+    // whole sim tick with a crowd of actors
+    Level level;
+    fillLevel(level, 20, 4000, 0.02, 3);
+    Player player;
+    player.width = 32;
+    player.height = 48;
+    player.x = 64;
+    player.y = 18 * kCell;
+    Simulation sim(level, player, kCell);
+    std::mt19937 rng(4);
+    for (int i = 0; i < 10000; ++i) {
+        ActorDesc d;
+        d.x = static_cast<float>(rng() % (4000 * kCell));
+        d.y = static_cast<float>(rng() % (18 * kCell));
+        d.vx = (rng() & 1) ? 60.0f : -60.0f;
+        sim.actors().spawn(d);
+    }
+    PlayerInput input;
+    input.right = true;
+    bench::run(opt, "sim/tick_10k_actors", 10000, [&] {
+        sim.tick(input, 1.0 / 120.0);
+        if (sim.finished()) player.x = 64; // keep the run going
+    }, out);
+}
+
+void benchRender(const bench::Options& opt, SDL_Renderer* ren, const std::string& assetsDir, std::vector<bench::Result>& out) {
+    Level level;
+    fillLevel(level, kViewH / kCell + 1, 2000, 0.1, 5);
+    const int maxCam = level.cols() * kCell - kViewW;
+
+    for (bool baked : { false, true }) {
+        TileRenderer tiles;
+        tiles.attach(&level);
+        tiles.setBaking(baked);
+        int cam = 0;
+        bench::run(opt, baked ? "render/tiles_baked" : "render/tiles_direct", (kViewW / kCell + 1) * (kViewH / kCell + 1), [&] {
+            tiles.render(ren, level, cam, kViewW, kViewH, kCell, kCell);
+            cam = (cam + 7) % maxCam; // pan, so baked chunks keep rolling in
+        }, out);
+    }
+
+    Texture bgTex;
+    if (!bgTex.load(ren, assetsDir + "poziom_1_tlo.jpg")) {
+        for (const char* name : { "render/background", "render/background_8_layers", "render/full_frame" })
+            bench::skip(opt, name, "background image not found", out);
+        return;
+    }
+    Background bg;
+    bg.setTexture(bgTex.tex);
+    bg.setFrameSize(kViewW, kViewH);
+    bg.setParallax(0.25f);
+    bg.setRepeat(false);
+    float camF = 0.0f;
+    bench::run(opt, "render/background", 0, [&] {
+        bg.setOffsetFromCamera(camF, static_cast<float>(maxCam), 1.0f / 60.0f);
+        bg.update(1.0f / 60.0f);
+        bg.render(ren);
+        camF = camF + 7.0f > maxCam ? 0.0f : camF + 7.0f;
+    }, out);
+
+    // 8-layer parallax scene: metrics are cached, so this is 1-2 copies per layer
+    Background layered;
+    layered.setFrameSize(kViewW, kViewH);
+    for (int i = 0; i < 8; ++i) layered.addLayer(bgTex.tex, 0.1f + 0.1f * i, true);
+    camF = 0.0f;
+    bench::run(opt, "render/background_8_layers", 8, [&] {
+        layered.setOffsetFromCamera(camF, static_cast<float>(maxCam), 1.0f / 60.0f);
+        layered.update(1.0f / 60.0f);
+        layered.render(ren);
+        camF = camF + 7.0f > maxCam ? 0.0f : camF + 7.0f;
+    }, out);
+
+    TileRenderer tiles;
+    tiles.attach(&level);
+    int cam = 0;
+    bench::run(opt, "render/full_frame", 0, [&] {
+        SDL_SetRenderDrawColor(ren, 50, 50, 80, 255);
+        SDL_RenderClear(ren);
+        bg.setOffsetFromCamera(static_cast<float>(cam), static_cast<float>(maxCam), 1.0f / 60.0f);
+        bg.update(1.0f / 60.0f);
+        bg.render(ren);
+        tiles.render(ren, level, cam, kViewW, kViewH, kCell, kCell);
+        SDL_RenderPresent(ren);
+        cam = (cam + 7) % maxCam;
+    }, out);
+}
+
+void benchSave(const bench::Options& opt, std::vector<bench::Result>& out) {
+    Level level;
+    fillLevel(level, 64, 100000, 0.02, 6);
+    const std::string path = "projekcik_bench_level.zip";
+    bench::run(opt, "io/save_zip_64x100000", 64.0 * 100000, [&] { level.saveToZip(path); }, out);
+
+    Level loaded;
+    bench::run(opt, "io/load_zip_64x100000", 64.0 * 100000, [&] { loaded.loadFromZip(path); }, out);
+    std::remove(path.c_str());
+}
+
+void benchEditor(const bench::Options& opt, std::vector<bench::Result>& out) {
+    // 50 x 2000 = 100k cells per operation, toggled so every run changes them all
+    Level level;
+    level.grid.assign(50, 2000, TILE_EMPTY);
+    LevelEditor editor(&level, kViewW, kViewH);
+    TileGrid::Tile v = TILE_EMPTY;
+    bench::run(opt, "editor/fill_rect_100k", 100000, [&] {
+        v = v == TILE_SOLID ? TILE_EMPTY : TILE_SOLID;
+        editor.fillRect(0, 0, 49, 1999, v);
+    }, out);
+    bench::run(opt, "editor/flood_fill_100k", 100000, [&] {
+        v = v == TILE_SOLID ? TILE_PICKUP : TILE_SOLID;
+        editor.floodFill(0, 0, v);
+    }, out);
+    bench::run(opt, "editor/undo_redo_100k", 200000, [&] {
+        editor.undo();
+        editor.redo();
+    }, out);
+}
+
+void benchTextures(const bench::Options& opt, SDL_Renderer* ren, const std::string& assetsDir, std::vector<bench::Result>& out) {
+    const char* files[] = { "chodzenie_1.png", "menu_glowne_1.png", "poziom_1_tlo.jpg" };
+    for (const char* f : files) {
+        Texture t;
+        std::string path = assetsDir + f;
+        if (!t.load(ren, path)) {
+            bench::skip(opt, std::string("texture/load/") + f, "not found", out);
+            continue;
+        }
+        double pixels = static_cast<double>(t.w) * t.h;
+        bench::run(opt, std::string("texture/load/") + f, pixels, [&] { t.load(ren, path); }, out);
+    }
+
+    // level background the way the game loads it: resampled to the view + mips
+    Texture bg;
+    TextureFit fit;
+    fit.maxHeight = kViewH;
+    fit.mipLevels = 3;
+    std::string bgPath = assetsDir + "poziom_1_tlo.jpg";
+    if (bg.load(ren, bgPath, fit)) {
+        bench::run(opt, "texture/load_fit/poziom_1_tlo.jpg", 0, [&] { bg.load(ren, bgPath, fit); }, out);
+    } else {
+        bench::skip(opt, "texture/load_fit/poziom_1_tlo.jpg", "not found", out);
+    }
+}
+
+void benchText(const bench::Options& opt, SDL_Renderer* ren, const std::string& assetsDir, std::vector<bench::Result>& out) {
+    TextRenderer text(ren, assetsDir + "DejaVuSans.ttf", 24);
+    if (!text.ok()) {
+        for (const char* name : { "text/atlas_draw_hud_line", "text/cached_set_changing", "text/cached_draw" })
+            bench::skip(opt, name, "font not loaded", out);
+        return;
+    }
+    const SDL_Color black{ 0, 0, 0, 255 };
+    const std::string hint = "Edytor: strzałki - ruch, lewy myszki - klocek (cykluje wartościami)";
+    bench::run(opt, "text/atlas_draw_hud_line", static_cast<double>(hint.size()), [&] { text.draw(hint, 10, 10, black); }, out);
+
+    CachedText score(&text, black);
+    int n = 0;
+    bench::run(opt, "text/cached_set_changing", 0, [&] { score.set("Punkty: " + std::to_string(n++)); }, out);
+    bench::run(opt, "text/cached_draw", 0, [&] { score.draw(10, 10); }, out);
+}
+}
+
+int main(int argc, char* argv[]) {
+    bench::Options opt;
+    std::string outPath;
+    std::string assetsDir;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--assets" && i + 1 < argc) assetsDir = argv[++i];
+        else if (a == "--out" && i + 1 < argc) outPath = argv[++i];
+        else if (a == "--filter" && i + 1 < argc) opt.filter = argv[++i];
+        else if (a == "--quick") { opt.samples = 5; opt.minSampleMs = 5.0; }
+        else {
+            std::fprintf(stderr, "usage: %s [--assets DIR] [--out FILE] [--filter TEXT] [--quick]\n", argv[0]);
+            return 2;
+        }
+    }
+    bool packed = false;
+    if (assetsDir.empty()) {
+        char* base = SDL_GetBasePath();
+        std::string baseDir = base ? base : "";
+        if (base) SDL_free(base);
+        assetsDir = baseDir + "assets/";
+        // same lookup as the game: the packed archive first, loose files as fallback
+        packed = AssetArchive::mount(baseDir + "assets.pak", assetsDir);
+    }
+    if (!assetsDir.empty() && assetsDir.back() != '/' && assetsDir.back() != '\\') assetsDir += '/';
+    std::fprintf(stderr, "assets: %s%s\n", assetsDir.c_str(), packed ? " (assets.pak)" : "");
+
+    // no display on build boxes: dummy video driver, software renderer on a surface
+    SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+    if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+        std::fprintf(stderr, "SDL_Init failed: %s\n", SDL_GetError());
+        return 1;
+    }
+    SDL_LogGetOutputFunction(&defaultLog, &defaultLogData);
+    SDL_LogSetOutputFunction(benchLog, defaultLogData);
+    IMG_Init(IMG_INIT_JPG | IMG_INIT_PNG);
+    TTF_Init();
+
+    SDL_Surface* target = SDL_CreateRGBSurfaceWithFormat(0, kViewW, kViewH, 32, SDL_PIXELFORMAT_RGBA32);
+    SDL_Renderer* ren = target ? SDL_CreateSoftwareRenderer(target) : nullptr;
+    if (!ren) {
+        std::fprintf(stderr, "software renderer failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    std::vector<bench::Result> results;
+    benchCollision(opt, results);
+    benchRender(opt, ren, assetsDir, results);
+    benchSave(opt, results);
+    benchEditor(opt, results);
+    benchTextures(opt, ren, assetsDir, results);
+    benchText(opt, ren, assetsDir, results);
+
+    SDL_version v;
+    SDL_GetVersion(&v);
+    SDL_RendererInfo info;
+    SDL_GetRendererInfo(ren, &info);
+    char sdlVersion[32];
+    std::snprintf(sdlVersion, sizeof(sdlVersion), "%d.%d.%d", v.major, v.minor, v.patch);
+    std::vector<std::pair<std::string, std::string>> context = {
+        { "sdl_version", sdlVersion },
+        { "video_driver", SDL_GetCurrentVideoDriver() ? SDL_GetCurrentVideoDriver() : "none" },
+        { "renderer", info.name ? info.name : "?" },
+        { "samples", std::to_string(opt.samples) },
+    };
+
+    FILE* f = outPath.empty() ? stdout : std::fopen(outPath.c_str(), "w");
+    if (!f) {
+        std::fprintf(stderr, "cannot write %s\n", outPath.c_str());
+        return 1;
+    }
+    bench::writeJson(f, context, results);
+    if (f != stdout) std::fclose(f);
+
+    SDL_DestroyRenderer(ren);
+    SDL_FreeSurface(target);
+    TTF_Quit();
+    IMG_Quit();
+    SDL_Quit();
+    AssetArchive::unmount();
+
+    // a requested case that couldn't run is a failed benchmark run, not a quiet gap
+    bool anySkipped = std::any_of(results.begin(), results.end(), [](const bench::Result& r) { return !r.skipped.empty(); });
+    return anySkipped ? 3 : 0;
+}
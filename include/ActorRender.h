@@ -0,0 +1,8 @@
+#pragma once
+#include <SDL.h>
+
+class ActorStore;
+
+// Draw alive actors as filled boxes, one SDL_RenderFillRects batch per kind.
+// Positions are interpolated with alpha like Player::render.
+void renderActors(SDL_Renderer* r, const ActorStore& actors, int camX, int camY, float renderScale = 1.0f, float alpha = 1.0f);
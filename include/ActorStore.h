@@ -0,0 +1,89 @@
+#pragma once
+#include "TileOccupancy.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Level;
+
+enum ActorKind : uint8_t {
+    ACTOR_ENEMY = 0,
+    ACTOR_PROJECTILE = 1,
+    ACTOR_PLATFORM = 2,
+    ACTOR_KIND_COUNT = 3
+};
+
+enum ActorFlags : uint8_t {
+    ACTOR_ALIVE = 1 << 0,
+    ACTOR_COLLIDES = 1 << 1,    // resolved against solid/damaging tiles
+    ACTOR_ON_GROUND = 1 << 2,
+    ACTOR_FACING_LEFT = 1 << 3,
+    ACTOR_DIE_ON_HIT = 1 << 4,  // projectiles: removed on first tile contact
+    ACTOR_TURN_AT_WALL = 1 << 5 // patrols: reverse vx when blocked sideways
+};
+
+// Spawn parameters; defaults describe a walking enemy
+struct ActorDesc {
+    ActorKind kind = ACTOR_ENEMY;
+    float x = 0.f, y = 0.f;   // left, feet (same convention as Player)
+    float vx = 0.f, vy = 0.f; // px/s
+    float w = 32.f, h = 32.f;
+    float gravity = 1.f;      // multiplier on world gravity (0 = floats)
+    uint8_t flags = ACTOR_COLLIDES | ACTOR_TURN_AT_WALL;
+    uint16_t frameCount = 1;
+    float frameDelay = 150.f; // ms per frame
+};
+
+// Structure-of-arrays store for many simple moving entities (enemies,
+// projectiles, platforms). Each component is its own contiguous column so
+// the per-tick kernels are straight loops the compiler can vectorize;
+// index i is the same actor in every column. Removal is deferred to
+// compact(), which swap-removes dead actors, so indices are stable within
+// a tick only.
+class ActorStore {
+public:
+    // Components (read freely; write through the kernels or spawn/kill)
+    std::vector<float> x, y;         // left, feet
+    std::vector<float> prevX, prevY; // previous tick, for render interpolation
+    std::vector<float> vx, vy;
+    std::vector<float> w, h;
+    std::vector<float> gravity;
+    std::vector<uint8_t> flags;
+    std::vector<uint8_t> kind;
+    std::vector<float> animTime; // ms into the current frame
+    std::vector<float> animDelay;
+    std::vector<uint16_t> animFrame;
+    std::vector<uint16_t> animFrames;
+
+    int size() const { return static_cast<int>(x.size()); }
+    int aliveCount() const { return alive; }
+    void reserve(size_t n);
+    void clear();
+
+    int spawn(const ActorDesc& d);
+    // Marks dead and stops it; storage is reclaimed by compact()
+    void kill(int i);
+    // Drop dead actors (swap-remove); returns how many were removed
+    int compact();
+
+    // --- per-tick kernels, in this order ---
+    void storePrevious();
+    // Gravity and velocity integration: vy += g*gravity*dt, pos += v*dt
+    void integrate(float dt, float worldGravity = 1200.f, float maxFallSpeed = 900.f);
+    // Push colliding actors out of solid/damaging tiles (occupancy broadphase)
+    void resolveTiles(Level& level, int cellSize);
+    void animate(float dt);
+    // Kill actors wholly outside [minX, maxX] x [minY, maxY]; returns count
+    int killOutside(float minX, float minY, float maxX, float maxY);
+
+    float renderX(int i, float alpha) const { return prevX[i] + (x[i] - prevX[i]) * alpha; }
+    float renderY(int i, float alpha) const { return prevY[i] + (y[i] - prevY[i]) * alpha; }
+
+private:
+    void resizeColumns(size_t n);
+    void moveActor(size_t from, size_t to);
+
+    int alive = 0;
+    // resolveTiles scratch, kept so ticks don't allocate
+    std::vector<TileOccupancy::Span> spans;
+};
@@ -0,0 +1,75 @@
+#pragma once
+#include <SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Read-only packed asset archive (built by projekcik_pack).
+//
+// Layout (little endian):
+//   header  "PKAR" | u32 version | u32 count | u32 reserved
+//   index   count x { u64 nameHash | u64 offset | u64 size | u64 dataHash |
+//                     u16 nameLen | name bytes }, sorted by nameHash
+//   data    each file 16-byte aligned
+//
+// The file is memory-mapped once; lookups are a binary search over the index
+// and entries are handed out as const memory, so SDL_image/SDL_ttf decode
+// straight from the mapping without copies or per-file opens.
+class AssetArchive {
+public:
+    static constexpr uint32_t kMagic = 0x52414B50; // "PKAR"
+    static constexpr uint32_t kVersion = 1;
+    static constexpr size_t kHeaderBytes = 16;
+    static constexpr size_t kAlign = 16;
+
+    struct Entry {
+        uint64_t nameHash = 0;
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        uint64_t dataHash = 0;
+        std::string name;
+    };
+
+    AssetArchive();
+    ~AssetArchive();
+
+    AssetArchive(const AssetArchive&) = delete;
+    AssetArchive& operator=(const AssetArchive&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const;
+
+    // Archive-relative name ("chodzenie_1.png"); null if missing
+    const uint8_t* find(const std::string& name, size_t* size) const;
+    // Read-only RWops over the mapped bytes (free with SDL_RWclose / freesrc)
+    SDL_RWops* openRW(const std::string& name) const;
+
+    const std::vector<Entry>& entries() const;
+    // Re-hash every entry and compare against the index
+    bool verify() const;
+
+    // FNV-1a, used for both names and contents
+    static uint64_t hash(const void* data, size_t len);
+
+    // Process-wide archive used by asset loaders. Paths starting with
+    // rootPrefix are looked up in the archive; everything else (and anything
+    // not packed) falls back to the filesystem.
+    static bool mount(const std::string& archivePath, const std::string& rootPrefix);
+    static void unmount();
+    static SDL_RWops* openFile(const std::string& path);
+
+private:
+    bool parseIndex();
+
+    const uint8_t* base;
+    size_t length;
+    std::vector<Entry> index;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mapHandle;
+#else
+    int fd;
+#endif
+};
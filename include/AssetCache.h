@@ -0,0 +1,82 @@
+#pragma once
+#include <SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "AsyncImageLoader.h"
+#include "Texture.h"
+
+class TextureResidency;
+
+// Textures shared by path. The cache keeps a reference to every texture it
+// hands out, so returning to the menu or replaying a level decodes nothing.
+// Async requests decode on a worker thread; pump() uploads finished ones.
+// With a TextureResidency attached, textures only the cache references can
+// be evicted under memory pressure; the next texture()/textureAsync() for
+// the path reloads them (sync / in the background respectively).
+class AssetCache {
+public:
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t failures = 0;
+        size_t bytesResident = 0; // estimated GPU bytes (w * h * 4)
+        int textures = 0;
+        int pending = 0;          // async decodes not uploaded yet
+    };
+
+    explicit AssetCache(SDL_Renderer* renderer, TextureResidency* residency = nullptr);
+    ~AssetCache();
+
+    AssetCache(const AssetCache&) = delete;
+    AssetCache& operator=(const AssetCache&) = delete;
+
+    // Load-time resampling for path (see TextureFit), applied whenever the
+    // cache decodes it. Textures already resident keep their levels.
+    void setFit(const std::string& path, const TextureFit& fit);
+
+    // Shared texture for path, loading it on first request (null on failure)
+    std::shared_ptr<Texture> texture(const std::string& path);
+    // Re-decode path in place; existing handles see the new pixels
+    std::shared_ptr<Texture> reload(const std::string& path);
+
+    // Handle returned immediately; its tex stays null (draws nothing) until
+    // the background decode finishes and pump() uploads it
+    std::shared_ptr<Texture> textureAsync(const std::string& path);
+    void prefetch(const std::string& path);
+    bool ready(const std::string& path) const;
+    // Upload up to maxUploads finished decodes; call once per frame on the render thread
+    int pump(int maxUploads = 2);
+
+    bool contains(const std::string& path) const;
+    // Drop textures nobody but the cache references
+    void purgeUnused();
+    // Drop everything (call before destroying the renderer)
+    void clear();
+
+    Stats stats() const;
+    void logStats() const;
+    TextureResidency* residency() const;
+
+private:
+    SDL_Renderer* ren;
+    bool finishPending(const std::string& path, Texture& tex);
+    TextureFit fitFor(const std::string& path) const;
+    // Residency bookkeeping: loaded() after every successful load/upload,
+    // forget() before an entry leaves the map
+    void loaded(const std::string& path, const std::shared_ptr<Texture>& tex);
+    void forget(const std::string& path);
+    bool touch(const std::string& path);
+    bool evicted(const std::string& path) const;
+
+    std::unordered_map<std::string, std::shared_ptr<Texture>> textures;
+    std::unordered_map<std::string, TextureFit> fits;
+    TextureResidency* budget;
+    std::unordered_map<std::string, int> residencyIds;
+    AsyncImageLoader loader;
+    uint64_t hitCount;
+    uint64_t missCount;
+    uint64_t failCount;
+};
@@ -0,0 +1,55 @@
+#pragma once
+#include <SDL.h>
+#include "Texture.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Decodes images (file read + decode + RGBA32 conversion, plus any
+// TextureFit resampling) on a background thread. Finished surfaces are
+// collected on the render thread, which does only the texture upload.
+class AsyncImageLoader {
+public:
+    AsyncImageLoader();
+    ~AsyncImageLoader();
+
+    AsyncImageLoader(const AsyncImageLoader&) = delete;
+    AsyncImageLoader& operator=(const AsyncImageLoader&) = delete;
+
+    // Queue path for decoding (no-op if already queued, decoding or done)
+    void request(const std::string& path, const TextureFit& fit = TextureFit());
+    // Queued, decoding, or decoded but not yet collected
+    bool pending(const std::string& path) const;
+    int pendingCount() const;
+
+    // Take one finished decode: levels (largest first) is empty when decoding
+    // failed; the caller owns the surfaces. Returns false when nothing is ready.
+    bool poll(std::string& path, std::vector<SDL_Surface*>& levels);
+
+    // Take the decode for path now: waits if it's in flight, decodes on the
+    // calling thread if it hasn't started. Returns false if path was never requested.
+    bool take(const std::string& path, std::vector<SDL_Surface*>& levels);
+
+private:
+    void run();
+
+    mutable std::mutex mtx;
+    std::condition_variable wake;   // worker: new work / stop
+    std::condition_variable doneCv; // take(): a decode finished
+    struct Job {
+        std::string path;
+        TextureFit fit;
+    };
+
+    std::deque<Job> queue;
+    std::unordered_set<std::string> inFlight; // queued or decoding
+    std::unordered_map<std::string, std::vector<SDL_Surface*>> done;
+    std::deque<std::string> doneOrder;
+    bool stopping;
+    std::thread worker;
+};
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <SDL.h>
+#include <vector>
+
+// Scrolling level background (render side of a level): a stack of layers
+// drawn back to front, each with its own parallax factor, repeat mode,
+// auto-scroll and max speed. Texture size and the scaled metrics are cached
+// when a texture or the frame size changes, so a frame only moves offsets
+// and emits the visible copies of each layer.
+//
+// The single-layer setters (setTexture, setParallax, ...) act on layer 0.
+class Background {
+public:
+    Background();
+    ~Background();
+
+    // Background update and render
+    void update(float dt);
+    void render(SDL_Renderer* renderer);
+
+    // Layers, back to front; returns the new layer's index
+    int addLayer(SDL_Texture* tex, float parallax, bool repeat = true, float maxSpeed = -1.0f);
+    void clearLayers();
+    int layerCount() const;
+
+    void setLayerTexture(int layer, SDL_Texture* tex);
+    void setLayerParallax(int layer, float factor);
+    void setLayerRepeat(int layer, bool repeat);
+    void setLayerScrollSpeed(int layer, float speed);
+    void setLayerMaxSpeed(int layer, float pxPerSec);
+
+    // control background repeat
+    void setRepeat(bool repeat);
+
+    // Setters
+    void setTexture(SDL_Texture* tex);
+    void setFrameSize(int width, int height);
+    void setScrollSpeed(float speed);
+
+    // Parallax: 0 = fixed, 1 = follow
+    void setParallax(float factor);
+
+    // Update background offsets based on camera X position
+    void setOffsetFromCamera(float camX, float maxCam, float dt);
+
+    // Set maximum background speed in pixels/sec (<=0 = unlimited)
+    void setMaxSpeed(float pxPerSec);
+
+    // Add getters for frame size
+    int getFrameWidth() const;
+    int getFrameHeight() const;
+
+private:
+    struct Layer {
+        SDL_Texture* tex = nullptr;
+        // cached by refreshMetrics(); scaledW == 0 means nothing to draw
+        int texW = 0;
+        int texH = 0;
+        int scaledW = 0;
+        int maxOffset = 0; // non-repeating: scroll range in frame pixels
+
+        float offset = 0.0f;
+        float scrollSpeed = 0.0f;
+        float parallax = 0.5f;
+        float maxSpeed = -1.0f; // px/sec for camera-driven moves, <=0 = unlimited
+        bool repeat = true;
+
+        // Previous camera X for delta calculations
+        float prevCamX = 0.0f;
+        bool prevCamValid = false;
+    };
+
+    Layer* layer(int i);
+    // Layer 0, created on demand for the single-layer setters
+    Layer& baseLayer();
+    void refreshMetrics(Layer& l);
+    void moveWithCamera(Layer& l, float camX, float maxCam, float dt);
+
+    std::vector<Layer> layers;
+    int frameWidth;
+    int frameHeight;
+};
@@ -0,0 +1,129 @@
+#pragma once
+#include "TileGrid.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Tile map split into fixed-size chunks (kChunkRows x kChunkCols).
+// Only chunks near the camera stay resident as flat TileGrids; the rest are
+// kept run-length packed (or not at all when empty) and paged in on access.
+// Resident memory is bounded by a byte budget with LRU eviction.
+class ChunkedTileMap {
+public:
+    using Tile = TileGrid::Tile;
+
+    static constexpr int kChunkRowShift = 4;
+    static constexpr int kChunkColShift = 6;
+    static constexpr int kChunkRows = 1 << kChunkRowShift; // 16
+    static constexpr int kChunkCols = 1 << kChunkColShift; // 64
+    static constexpr size_t kChunkBytes = static_cast<size_t>(kChunkRows) * kChunkCols;
+
+    // Notified after a cell's value changes. (-1, -1) means the whole map was
+    // reset (assign/clear) and any derived data must be rebuilt.
+    using ChangeListener = std::function<void(int r, int c, Tile oldValue, Tile newValue)>;
+
+    ChunkedTileMap();
+    ChunkedTileMap(int rows, int cols);
+    ~ChunkedTileMap();
+
+    ChunkedTileMap(const ChunkedTileMap&) = delete;
+    ChunkedTileMap& operator=(const ChunkedTileMap&) = delete;
+
+    int rows() const { return nRows; }
+    int cols() const { return nCols; }
+
+    // Reset to rows x cols filled with v
+    void assign(int rows, int cols, Tile v = TILE_EMPTY);
+    // Reset to rows x cols, filling row r from fillRow(r, out) (out holds cols
+    // tiles). Rows are requested in order and written a chunk band at a time,
+    // so each chunk is touched once; listeners get a single reset at the end.
+    void assignRows(int rows, int cols, const std::function<void(int r, Tile* out)>& fillRow);
+    // Grow (never shrink) so that (r, c) is a valid cell; allocates no chunks
+    void ensure(int r, int c);
+    void clear();
+
+    // Out-of-range reads return TILE_EMPTY, out-of-range writes are ignored.
+    // Non-resident chunks are paged in transparently.
+    Tile get(int r, int c) const {
+        if (r < 0 || c < 0 || r >= nRows || c >= nCols) return TILE_EMPTY;
+        const Slot& s = slots[slotIndex(r >> kChunkRowShift, c >> kChunkColShift)];
+        if (s.data) return s.data->row(r & (kChunkRows - 1))[c & (kChunkCols - 1)];
+        if (s.packed.empty()) return TILE_EMPTY;
+        return pageIn(r >> kChunkRowShift, c >> kChunkColShift).row(r & (kChunkRows - 1))[c & (kChunkCols - 1)];
+    }
+    void set(int r, int c, Tile v);
+
+    // Copy row r, columns [c0, c0 + count), into out. Does not page chunks in,
+    // so whole-level scans (saving) don't thrash the resident set.
+    void copyRow(int r, int c0, int count, Tile* out) const;
+
+    // Copy the whole map into dst as packed chunks only (dirty resident chunks
+    // are packed on the way). Cost scales with the compressed size, so it is
+    // cheap enough to call on the main thread before a background save.
+    void snapshotTo(ChunkedTileMap& dst) const;
+
+    // Keep chunks overlapping columns [colMin, colMax] resident (pinned) and
+    // evict least recently used chunks beyond the budget.
+    void streamColumns(int colMin, int colMax);
+
+    // Budget for resident (unpacked) chunk memory in bytes
+    void setResidentBudget(size_t bytes);
+    size_t residentBudget() const;
+
+    // Change listeners (renderer caches, indices); returns an id for removal
+    int addChangeListener(ChangeListener listener);
+    void removeChangeListener(int id);
+
+    // Stats
+    int residentChunks() const;
+    size_t residentBytes() const;
+    size_t packedBytes() const;
+    uint64_t pageIns() const;
+    uint64_t evictions() const;
+
+private:
+    struct Slot {
+        std::unique_ptr<TileGrid> data;  // resident tiles, or null
+        std::vector<uint8_t> packed;     // RLE copy, empty = all TILE_EMPTY
+        uint64_t lastUse = 0;
+        bool dirty = false;              // resident copy differs from packed
+    };
+
+    size_t slotIndex(int cr, int cc) const {
+        return static_cast<size_t>(cc) * slotRowCap + cr;
+    }
+
+    TileGrid& pageIn(int cr, int cc) const;
+    void evictSlot(size_t idx) const;
+    void enforceBudget(size_t keep) const;
+    void growSlots(int chunkRows, int chunkCols);
+
+    void notify(int r, int c, Tile oldValue, Tile newValue);
+
+    static void packChunk(const TileGrid& g, std::vector<uint8_t>& out);
+    static void unpackChunk(const std::vector<uint8_t>& in, TileGrid& g);
+
+    int nRows;
+    int nCols;
+    int slotRows;   // chunk rows in use
+    int slotCols;   // chunk columns in use
+    int slotRowCap; // chunk rows allocated per chunk column
+
+    // residency is a cache: logically-const reads may page chunks in/out
+    mutable std::vector<Slot> slots; // column-major by chunk column
+    mutable std::vector<size_t> resident;
+    mutable std::vector<std::unique_ptr<TileGrid>> pool;
+    mutable uint64_t useClock;
+    mutable uint64_t pageInCount;
+    mutable uint64_t evictCount;
+
+    std::vector<std::pair<int, ChangeListener>> listeners;
+    int nextListenerId;
+
+    size_t budget;
+    int pinMinChunkCol;
+    int pinMaxChunkCol;
+};
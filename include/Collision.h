@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+
+class Player;
+class Level;
+class TileOccupancy;
+
+// Push the player out of solid/damaging tiles, apply damage and collect pickups.
+// 0=empty, 1=solid, 2=damaging, 3=pickup
+void resolvePlayerCollisions(Player& player, Level& level, int cellW, int cellH);
+
+// Result of sweepBox: which axes were stopped, the fraction of the move made
+// on each axis (time of impact, 1 = unobstructed) and the tile classes hit
+// (TileOccupancy masks).
+struct SweepHit {
+    bool hitX = false;
+    bool hitY = false;
+    float toiX = 1.0f;
+    float toiY = 1.0f;
+    uint8_t classesX = 0;
+    uint8_t classesY = 0;
+};
+
+// Continuous move of the box (left, top, w, h) by (dx, dy) against tiles in
+// mask: X first, then Y from the new X, each stopping flush against the first
+// occupied tile in its path, so the box slides along surfaces and can't
+// tunnel however large the step. Tiles the box already overlaps are ignored.
+SweepHit sweepBox(const TileOccupancy& occ, uint8_t mask, float& left, float& top, float w, float h,
+                  float dx, float dy, int cellW, int cellH);
+
+// Swept version of the player/tile response: re-applies the move made since
+// (fromX, fromY) continuously, lands/bumps on solid and damaging tiles,
+// applies contact damage and collects pickups along the path.
+void movePlayerSwept(Player& player, Level& level, float fromX, float fromY, int cellW, int cellH);
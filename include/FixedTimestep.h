@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+
+// Fixed-rate simulation clock.
+// Accumulates wall-clock frame time and hands out a whole number of constant
+// ticks per frame; the leftover fraction is used to interpolate rendering.
+class FixedTimestep {
+public:
+    explicit FixedTimestep(double tickRate = 120.0, int maxStepsPerFrame = 8);
+
+    void setTickRate(double hz);
+    void setMaxSteps(int steps);
+
+    double tickRate() const;
+    double tickDt() const;
+
+    // Feed frame time (seconds), returns number of ticks to simulate now.
+    // Time beyond maxSteps ticks is dropped so a hitch can't snowball.
+    int advance(double frameDt);
+
+    // Interpolation factor in [0,1) between the previous and current tick
+    float alpha() const;
+
+    // Total ticks handed out since construction / reset
+    uint64_t totalTicks() const;
+    // Ticks dropped because a frame exceeded maxSteps
+    uint64_t droppedTicks() const;
+
+    void reset();
+
+private:
+    double rate;
+    double dt;
+    int maxSteps;
+    double accumulator;
+    uint64_t ticks;
+    uint64_t dropped;
+};
@@ -0,0 +1,53 @@
+#pragma once
+#include <SDL.h>
+#include <vector>
+
+// Paces a render loop to a target frame rate without a fixed sleep.
+// Waits against SDL_GetPerformanceCounter deadlines: sleeps (SDL_Delay) while
+// the deadline is far, then spins the last stretch. The spin margin adapts to
+// how late SDL_Delay actually wakes on this machine, so coarse OS timers cost
+// a little CPU instead of a missed frame. Target 0 = uncapped (vsync only):
+// wait() just measures.
+class FramePacer {
+public:
+    explicit FramePacer(double targetFps = 0.0, int historyFrames = 240);
+
+    void setTargetFps(double fps);
+    double targetFps() const;
+
+    // Call once per frame after present; returns the time spent waiting (ms)
+    double wait();
+    // Forget the deadline (after a long stall such as loading a level) so
+    // the next frame doesn't try to catch up
+    void resync();
+
+    // Frame period = time between successive wait() returns
+    double lastFrameMs() const;
+    double avgFrameMs() const;
+    // Standard deviation of the frame period over the history
+    double jitterMs() const;
+    // How late wait() returned relative to its deadline (capped mode only)
+    double avgOvershootMs() const;
+    double maxOvershootMs() const;
+    // Current sleep-to-spin switch point (ms before the deadline)
+    double spinMarginMs() const;
+
+    void logStats(const char* label) const;
+
+private:
+    double toMs(Uint64 ticks) const;
+    void record(Uint64 now, double overshootMs);
+
+    double fps;
+    Uint64 period;   // counter ticks per frame, 0 = uncapped
+    Uint64 deadline; // end of the current frame, 0 = not started
+    Uint64 lastReturn;
+    double freq;     // counter ticks per ms
+    double spinMs;   // adaptive; starts at 2 ms
+
+    // ring buffers of the last N frames
+    std::vector<float> frameHist;
+    std::vector<float> overshootHist;
+    int head;
+    int count;
+};
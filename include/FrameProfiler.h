@@ -0,0 +1,92 @@
+#pragma once
+#include <SDL.h>
+#include <string>
+#include <vector>
+
+class TextRenderer;
+
+// Frame phases timed by the profiler, in frame order
+enum ProfPhase {
+    PROF_EVENTS = 0,
+    PROF_PLAYER_UPDATE,
+    PROF_COLLISIONS,
+    PROF_ACTORS,
+    PROF_BACKGROUND,
+    PROF_TILES,
+    PROF_SPRITES,
+    PROF_HUD,
+    PROF_PRESENT,
+    PROF_SLEEP,
+    PROF_PHASE_COUNT
+};
+
+// Per-phase frame timings (SDL performance counter) kept in a ring buffer of
+// the last N frames, with averages/p99 for the overlay and a CSV dump.
+// Phases may be entered several times a frame (sim ticks); times add up.
+class FrameProfiler {
+public:
+    // RAII timer for one phase; a null profiler makes it a no-op
+    class Scope {
+    public:
+        Scope(FrameProfiler* p, ProfPhase phase)
+            : prof(p)
+            , ph(phase)
+            , start(p ? SDL_GetPerformanceCounter() : 0)
+        {
+        }
+        ~Scope() {
+            if (prof) prof->add(ph, prof->toMs(SDL_GetPerformanceCounter() - start));
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        FrameProfiler* prof;
+        ProfPhase ph;
+        Uint64 start;
+    };
+
+    struct Stats {
+        double avg = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+    };
+
+    explicit FrameProfiler(int historyFrames = 240);
+
+    void beginFrame();
+    void endFrame();
+    void add(ProfPhase phase, double ms);
+
+    // Stats over the frames in the ring; phase = PROF_PHASE_COUNT means whole frames
+    Stats stats(int phase) const;
+    int frameCount() const;
+    // Whole-frame time, ago = 0 is the last finished frame
+    double frameMs(int ago) const;
+    int capacity() const;
+
+    // Ring contents, oldest first, one row per frame
+    bool dumpCsv(const std::string& path) const;
+
+    static const char* phaseName(int phase);
+
+    void setOverlayVisible(bool v);
+    bool overlayVisible() const;
+    // Text table + frame-time graph (game target only, see ProfilerOverlay.cpp)
+    void renderOverlay(SDL_Renderer* r, TextRenderer& text, int x, int y);
+
+    double toMs(Uint64 ticks) const { return static_cast<double>(ticks) * msPerTick; }
+
+private:
+    static constexpr int kColumns = PROF_PHASE_COUNT + 1; // phases + frame total
+
+    int cap;
+    int head;   // next row to write
+    int filled;
+    std::vector<double> ring; // cap rows x kColumns
+    double current[PROF_PHASE_COUNT];
+    Uint64 frameStart;
+    double msPerTick;
+    bool overlay;
+    std::vector<SDL_Point> graphPts; // renderOverlay scratch
+};
@@ -0,0 +1,17 @@
+#pragma once
+#include <cstdint>
+
+// CPU image resampling for load-time preprocessing (no renderer involved, so
+// it runs on the asset loader thread). Pixels are 8-bit RGBA in memory order
+// (SDL_PIXELFORMAT_RGBA32). Filtering is separable Mitchell-Netravali
+// (B = C = 1/3) widened by the scale factor when shrinking, done in linear
+// light on premultiplied alpha so edges and dark detail don't smear.
+namespace ImageResample {
+// Resample src (sw x sh, spitch bytes per row) into dst (dw x dh, dpitch).
+// Returns false on bad sizes.
+bool resize(const uint8_t* src, int sw, int sh, int spitch,
+            uint8_t* dst, int dw, int dh, int dpitch);
+
+// Size that fits within maxH rows keeping the aspect ratio; never enlarges
+void fitHeight(int w, int h, int maxH, int& outW, int& outH);
+}
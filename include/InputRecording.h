@@ -0,0 +1,137 @@
+#pragma once
+#include "Level.h"
+#include "Player.h"
+#include "Simulation.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// A recorded play session: the level and player as they were when recording
+// began, then the input of every fixed sim tick plus editor writes. Feeding
+// it back through a Simulation with the same tick dt reproduces the run
+// exactly; state checksums taken while recording tell whether it did.
+//
+// File format (little endian):
+//   u32 magic "PREC" | u16 version | u16 flags | f64 tickDt | u32 cellSize
+//   u32 checksumEvery | player block | u32 levelSize | LevelFormat bytes
+//   u64 ticks | input runs { varint length | u8 bits } covering ticks
+//   u32 editCount | edits { varint tick delta | varint row | varint col | u8 value }
+//   u32 checksumCount | checksumCount x u64
+struct InputRecording {
+    static constexpr uint32_t kMagic = 0x43455250; // "PREC"
+    static constexpr uint16_t kVersion = 1;
+    // Longest recording accepted on load (about 155 hours at 120 Hz), so a
+    // corrupt tick count can't make the input buffer grow without bound
+    static constexpr uint64_t kMaxTicks = 1ULL << 26;
+
+    // per-tick input bits
+    enum : uint8_t {
+        IN_LEFT = 1 << 0,
+        IN_RIGHT = 1 << 1,
+        IN_JUMP = 1 << 2,
+        IN_PAUSED = 1 << 3 // editor open: the tick only syncs interpolation
+    };
+
+    // Editor wrote `value` to (row, col) just before tick `tick`
+    struct Edit {
+        uint64_t tick = 0;
+        int row = 0;
+        int col = 0;
+        TileGrid::Tile value = TILE_EMPTY;
+    };
+
+    // Player state that affects the simulation (animation is not recorded)
+    struct PlayerStart {
+        float x = 0.f, y = 0.f, vy = 0.f;
+        int width = 64, height = 64;
+        int health = 3, score = 0;
+        float invuln = 0.5f, invulnTimer = 0.f;
+        bool onGround = false, facingLeft = false;
+
+        void capture(const Player& p);
+        void apply(Player& p) const;
+    };
+
+    double tickDt = 1.0 / 120.0;
+    int cellSize = 32;
+    uint32_t checksumEvery = 60; // ticks between checksums (0 = none)
+    PlayerStart player;
+    std::vector<uint8_t> level;  // LevelFormat::write output
+    std::vector<uint8_t> inputs; // one IN_* mask per tick
+    std::vector<Edit> edits;     // in tick order
+    // Simulation::checksum() after ticks checksumEvery, 2*checksumEvery, ...
+    std::vector<uint64_t> checksums;
+
+    static uint8_t pack(const PlayerInput& in, bool paused);
+    static PlayerInput unpack(uint8_t bits);
+
+    // Written to path + ".tmp" and renamed, like level saves
+    bool save(const std::string& path) const;
+    // On failure the recording is left untouched and error (if given) says why
+    bool load(const std::string& path, std::string* error = nullptr);
+};
+
+// Captures a session from the running game. begin() snapshots the level and
+// player; call tick() after every Simulation::tick.
+class InputRecorder {
+public:
+    // False (and not recording) when the level is too large to store
+    bool begin(const Level& level, const Player& player, double tickDt, int cellSize, uint32_t checksumEvery = 60);
+    bool active() const;
+    uint64_t ticks() const;
+
+    // Editor wrote value to (row, col) since the last tick
+    void edit(int row, int col, TileGrid::Tile value);
+    void tick(const PlayerInput& in, bool paused, const Simulation& sim);
+
+    // Write the session and stop recording
+    bool finish(const std::string& path);
+    // Stop without writing (e.g. the level was replaced mid-run)
+    void cancel();
+
+private:
+    InputRecording rec;
+    bool recording = false;
+};
+
+// Plays a recording back headless, one tick per step(), comparing the
+// simulation checksum against the recorded ones as it goes.
+class Replayer {
+public:
+    explicit Replayer(const InputRecording& recording);
+
+    // False when the embedded level could not be decoded (see error())
+    bool ok() const;
+    const std::string& error() const;
+
+    // Run one tick; false once the recording is exhausted
+    bool step();
+    // Back to the recorded starting state
+    bool restart();
+
+    uint64_t tick() const;
+    bool done() const;
+    uint64_t checksum() const;
+    // Checksums compared so far / how many differed; first bad tick (0 = none)
+    int checksumsCompared() const;
+    int mismatches() const;
+    uint64_t firstMismatchTick() const;
+
+    Simulation& simulation();
+    Level& level();
+    Player& player();
+
+private:
+    const InputRecording& rec;
+    Level lvl;
+    Player ply;
+    std::unique_ptr<Simulation> sim;
+    std::string err;
+    uint64_t pos;
+    size_t nextEdit;
+    int compared;
+    int bad;
+    uint64_t firstBad;
+    bool valid;
+};
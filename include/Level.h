@@ -1,72 +1,39 @@
 #pragma once
 
-#include <SDL.h>
+#include "ChunkedTileMap.h"
+#include "TileOccupancy.h"
 #include <string>
 #include <vector>
 
+// Level data: tile grid and asset references. No rendering here (see Background).
 class Level {
 public:
     Level();
     ~Level();
 
-    // Background update and render
-    void updateBackground(float dt);
-    void renderBackground(SDL_Renderer* renderer);
-
-    // control background repeat
-    void setBackgroundRepeat(bool repeat);
-
-    // Setters
-    void setBackgroundTexture(SDL_Texture* tex);
-    void setFrameSize(int width, int height);
-    void setScrollSpeed(float speed);
-
-    // Parallax: 0 = fixed, 1 = follow
-    void setParallax(float factor);
-
-    // Update background offset based on camera X position
-    void setBackgroundOffsetFromCamera(float camX, float maxCam, float dt);
-
-    // Set maximum background speed in pixels/sec (<=0 = unlimited)
-    void setBackgroundMaxSpeed(float pxPerSec);
-
-    // Add getters for frame size
-    int getFrameWidth() const;
-    int getFrameHeight() const;
-
-    // Level grid
-    int rows;
-    int cols;
-    std::vector<std::vector<int>> grid;
+    // Level grid (0=empty, 1=solid, 2=damaging, 3=pickup), chunked and
+    // streamed around the camera via grid.streamColumns()
+    ChunkedTileMap grid;
+    // Per-row occupancy bitsets over grid (collision broadphase), rebuilt lazily
+    TileOccupancy occupancy;
     std::string backgroundPath;
     std::vector<std::string> usedAssets;
 
+    int rows() const { return grid.rows(); }
+    int cols() const { return grid.cols(); }
+
     // Editor helpers
     void toggleCell(int r, int c);
     void ensureCell(int r, int c);
 
-    // Persist level
-    bool saveToZip(const std::string& path) const;
-
-private:
-    SDL_Texture* bgTexture;
-    int frameWidth;
-    int frameHeight;
-
-    // Background scroll state
-    float bgOffset;
-    float scrollSpeed;
-
-    // Background repeat flag
-    bool bgRepeat;
+    // Copy tiles and asset references into out (packed, no listeners), e.g.
+    // to save from a worker thread while this level keeps changing
+    void snapshotTo(Level& out) const;
 
-    // Parallax factor
-    float parallax;
-
-    // Previous camera X for delta calculations
-    float prevCamX;
-    bool prevCamValid;
-
-    // Maximum background movement speed in pixels/sec for camera-driven updates.
-    float bgMaxSpeed;
-};
\ No newline at end of file
+    // Persist level: zip holding the binary format from LevelFormat.h
+    // Written to path + ".tmp" and renamed, so a crash never leaves a torn file.
+    bool saveToZip(const std::string& path) const;
+    // Replaces grid and asset references; on failure the level is unchanged.
+    // Also reads the old text dumps written before the binary format.
+    bool loadFromZip(const std::string& path, std::string* error = nullptr);
+};
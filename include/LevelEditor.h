@@ -1,15 +1,132 @@
 #pragma once
 #include "Level.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <vector>
 
+// Grid editing for the in-game editor: cell cycling, line strokes, rectangle
+// and flood fills, copy/paste of regions, and undo/redo.
+// Each operation is one history entry holding only the cells it changed,
+// packed as row spans of run-length encoded (old, new) values, so a fill of a
+// uniform area costs a few bytes per row. The oldest entries are dropped once
+// the history goes over its byte limit.
 class LevelEditor {
 public:
+    using Tile = TileGrid::Tile;
+
+    // Told about every cell the editor writes, undo/redo included
+    using CellSink = std::function<void(int r, int c, Tile value)>;
+
+    // Copied tiles, row-major
+    struct Region {
+        int rows = 0;
+        int cols = 0;
+        std::vector<Tile> tiles;
+
+        bool empty() const { return tiles.empty(); }
+    };
+
+    static constexpr size_t kDefaultHistoryBytes = 8u << 20;
+    static constexpr size_t kDefaultFloodLimit = 1u << 20;
+
     LevelEditor(Level* l, int w, int h, float scale = 1.0f, int baseTile = 32);
-    void handleMouse(float mx, float my, float camX_editor_f);
+
+    void setWindowSize(int w, int h);
+    void setCellSink(CellSink sink);
+
+    // Editor pixel coordinates to a cell; false above or left of the grid
+    bool cellAt(float mx, float my, float camX_editor_f, int* outRow, int* outCol) const;
+    // Cycles one cell as an undo step, growing the grid as needed:
+    // 0 -> 1 -> 2 -> 3 -> 0 (empty -> solid -> damaging -> pickup -> empty)
+    bool cycle(int row, int col);
+
+    // Bulk operations. Each is one undo step and returns the cells changed.
+    // Corners may come in any order; the grid grows to fit non-empty writes.
+    size_t fillRect(int r0, int c0, int r1, int c1, Tile value);
+    // 4-connected fill inside the current grid. Gives up (changing nothing)
+    // when the area is larger than maxCells.
+    size_t floodFill(int row, int col, Tile value, size_t maxCells = kDefaultFloodLimit);
+
+    // Line painting while dragging: strokeTo() draws from the last point,
+    // endStroke() closes the undo step
+    void beginStroke(int row, int col, Tile value);
+    void strokeTo(int row, int col);
+    size_t endStroke();
+    bool stroking() const;
+
+    // Clipboard; cells outside the grid copy as empty
+    bool copy(int r0, int c0, int r1, int c1);
+    // Writes the clipboard with its top-left corner at (row, col)
+    size_t paste(int row, int col);
+    const Region& clipboard() const;
+
+    bool undo();
+    bool redo();
+    bool canUndo() const;
+    bool canRedo() const;
+    // Drop all history, e.g. after the level was replaced
+    void clearHistory();
+
+    void setHistoryLimit(size_t bytes);
+    size_t historyLimit() const;
+    size_t historyBytes() const;
+    size_t undoSteps() const;
+    size_t redoSteps() const;
 
 private:
+    struct Change {
+        int r;
+        int c;
+        Tile oldValue;
+        Tile newValue;
+    };
+
+    // Packed changes: per span varint row delta | varint col | varint length,
+    // then runs covering the span, each varint (count << 1 | literal) and
+    // either one (old << 4 | new) byte repeated count times or count literal
+    // bytes. Runs shorter than kMinRun go into literals, so even noisy edits
+    // stay near a byte per changed cell.
+    static constexpr size_t kMinRun = 3;
+
+    struct Entry {
+        std::vector<uint8_t> data;
+        size_t cells = 0;
+
+        size_t bytes() const { return sizeof(Entry) + data.capacity(); }
+    };
+
+    static uint8_t packTile(const Change& ch);
+    static Tile unpackTile(uint8_t b, bool newValue);
+
+    // Write one cell, remembering the change for the pending entry
+    void write(int r, int c, Tile v);
+    // Write without history (undo/redo)
+    void apply(int r, int c, Tile v);
+    void applyEntry(const Entry& e, bool redoing);
+    // Pack pending changes into a history entry; returns cells changed
+    size_t commit();
+    void revertPending();
+    void enforceLimit();
+
     Level* level;
     int windowW;
     int windowH;
     float tileScale;
     int baseTilePixels; // fixed tile size in pixels
-};
\ No newline at end of file
+
+    CellSink sink;
+    std::vector<Change> pending;
+    bool inStroke;
+    Tile strokeValue;
+    int strokeRow;
+    int strokeCol;
+
+    Region clip;
+
+    std::deque<Entry> history; // oldest first
+    size_t applied;            // entries [0, applied) can be undone
+    size_t historyUsed;
+    size_t historyCap;
+};
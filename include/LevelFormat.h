@@ -0,0 +1,43 @@
+#pragma once
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Level;
+
+// Binary level format (little endian), stored as "level.bin" inside the
+// level zip (which deflates it further):
+//   u32 magic "PLVL" | u16 version | u16 flags | u32 rows | u32 cols
+//   str background   | u32 assetCount | assetCount x str
+//   tiles: row-major runs of { varint length | u8 tile } covering rows*cols
+// where str = u16 length + UTF-8 bytes.
+namespace LevelFormat {
+constexpr uint32_t kMagic = 0x4C564C50; // "PLVL"
+constexpr uint16_t kVersion = 1;
+constexpr const char* kZipEntry = "level.bin";
+
+// Largest level accepted from a file, so a small corrupt file can't demand
+// gigabytes and pixel sizes (cells * cell size) always fit an int.
+// The biggest level in use (the benchmark's) is 64 x 100000.
+constexpr uint32_t kMaxRows = 1u << 12;
+constexpr uint32_t kMaxCols = 1u << 20;
+constexpr uint64_t kMaxCells = 1ULL << 24;
+constexpr int kMaxCellPixels = 64;
+// Worst-case tile stream is two bytes per cell, plus room for the header
+constexpr size_t kMaxFileBytes = static_cast<size_t>(2 * kMaxCells) + (1u << 20);
+static_assert(kMaxCells * kMaxCellPixels <= static_cast<uint64_t>(INT_MAX), "level pixel size must fit an int");
+
+bool dimensionsOk(uint64_t rows, uint64_t cols);
+
+// Fails (out left empty) for a level read() would reject as too large
+bool write(const Level& level, std::vector<uint8_t>& out, std::string* error = nullptr);
+// On failure the level is left untouched and error (if given) says why
+bool read(const uint8_t* data, size_t size, Level& level, std::string* error = nullptr);
+
+// Legacy JSON-like text dump (the old saveToZip output). Single pass, no DOM;
+// errors are reported as "line:col: message". Strings are taken verbatim up
+// to the closing quote, since the writer never escaped them.
+bool readText(const char* data, size_t size, Level& level, std::string* error = nullptr);
+}
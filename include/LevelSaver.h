@@ -0,0 +1,55 @@
+#pragma once
+#include "Level.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Saves levels without stalling the game loop: save() snapshots the level on
+// the calling thread (packed chunks, cheap) and a worker serializes and
+// writes it. Results are collected with poll() for UI feedback.
+class LevelSaver {
+public:
+    struct Result {
+        std::string path;
+        bool ok = false;
+        double ms = 0.0; // serialize + write time on the worker
+    };
+
+    LevelSaver();
+    // Finishes any queued save before returning, so quitting never loses one
+    ~LevelSaver();
+
+    LevelSaver(const LevelSaver&) = delete;
+    LevelSaver& operator=(const LevelSaver&) = delete;
+
+    // Snapshot now, write later. A save to the same path that hasn't started
+    // yet is replaced by the newer snapshot.
+    void save(const Level& level, const std::string& path);
+    bool busy() const;
+    // Block until every queued save has been written, e.g. before loading
+    // the file back
+    void flush();
+
+    // Take one finished save; false when nothing has completed
+    bool poll(Result& out);
+
+private:
+    struct Job {
+        std::string path;
+        std::unique_ptr<Level> snapshot;
+    };
+
+    void run();
+
+    mutable std::mutex mtx;
+    std::condition_variable wake;
+    std::condition_variable idle; // queue drained and nothing writing
+    std::deque<Job> queue;
+    std::deque<Result> results;
+    bool writing;
+    bool stopping;
+    std::thread worker;
+};
@@ -2,19 +2,35 @@
 #define MAINMENU_H
 
 #include <SDL.h>
+#include "FramePacer.h"
+#include <memory>
 #include <vector>
 #include <string>
 
+class AssetCache;
+class Texture;
+
 class MainMenu {
 public:
-    MainMenu(SDL_Renderer* ren, const std::string& assetsDir);
+    MainMenu(SDL_Renderer* ren, AssetCache& assets, const std::string& assetsDir);
     ~MainMenu();
     int run(); // returns level 0-9, -1 for kill
 
+    // Background image path for a level
+    static std::string levelBackground(const std::string& assetsDir, int level);
+
 private:
+    // Start decoding the highlighted level's background while browsing
+    void prefetchHighlighted();
+
     SDL_Renderer* ren;
-    std::vector<SDL_Texture*> textures;
+    AssetCache& assets;
+    std::string assetsDir;
+    // screens are looked up in the cache each frame rather than held, so the
+    // ones not on screen stay evictable under the texture budget
+    std::vector<std::string> screens;
     int currentIndex;
+    FramePacer pacer; // static screen: 60 fps is plenty
 };
 
 #endif
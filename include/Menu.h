@@ -1,14 +1,17 @@
 // cpp
 #pragma once
 #include <SDL.h>
-#include <SDL_ttf.h>
 #include <string>
 #include <vector>
 #include <functional>
+#include "TextRenderer.h"
+
+class TextureResidency;
 
 class Menu {
 public:
-    Menu(SDL_Renderer* renderer, const char* fontPath, int fontSize);
+    // Labels use text's font; the renderer is shared, not owned
+    Menu(SDL_Renderer* renderer, TextRenderer* text);
     ~Menu();
 
     void addItem(const std::string &label, std::function<void()> cb);
@@ -17,24 +20,30 @@ public:
     void toggle();
     bool visible() const;
 
+    // Account label textures against a texture budget; evicted labels are
+    // re-rendered when the menu is next drawn
+    void setResidency(TextureResidency* residency);
+
 private:
     struct Item {
         std::string label;
         std::function<void()> cb;
-        SDL_Texture* tex = nullptr;
-        int texW = 0, texH = 0;
+        CachedText text; // label rendered once
+        int residencyId = -1;
     };
     std::vector<Item> items_;
     size_t selected_ = 0;
     bool visible_ = false;
 
     SDL_Renderer* renderer_ = nullptr;
-    TTF_Font* font_ = nullptr;
+    TextRenderer* text_ = nullptr;
+    TextureResidency* residency_ = nullptr;
 
     // layout
     int x_ = 60, y_ = 60, w_ = 380, item_h_ = 28, padding_ = 8;
     SDL_Color bg_{0,0,0,200}, sel_{30,144,255,220}, border_{200,200,200,200}, textCol_{240,240,240,255};
 
     void createLabelTexture(Item &it);
-    void destroyTextures();
+    void trackItem(size_t index);
+    void untrackAll();
 };
\ No newline at end of file
@@ -1,13 +1,31 @@
-#include "Texture.h"
+#pragma once
 #include <vector>
 #include <SDL.h>
 
+// One animation frame: a region of a (possibly shared) atlas texture.
+// Size is cached so drawing never has to query the texture.
+struct SpriteFrame {
+    SDL_Texture* tex = nullptr;
+    SDL_Rect src{0, 0, 0, 0};
+};
+
+// Per-tick player controls, decoupled from the keyboard so the simulation
+// can be driven headless (replays, benchmarks).
+struct PlayerInput {
+    bool left = false;
+    bool right = false;
+    bool jump = false;
+
+    static PlayerInput fromKeyboard(const Uint8* kb);
+};
+
 class Player {
 public:
     float x = 100.f, y = 800.f;
+    float prevX = 100.f, prevY = 800.f; // position at the previous sim tick
     float vy = 0.f;
     bool onGround = false;
-    std::vector<Texture*> frames;
+    std::vector<SpriteFrame> frames;
     int curFrame = 0;
     double frameTime = 0;
     double frameDelay = 150.0; // ms per frame
@@ -20,6 +38,13 @@ public:
     float invulnTimer = 0.0f; // timer for invulnerability
     bool facingLeft = false;
 
+    void update(double dt, const PlayerInput& in);
     void update(double dt, const Uint8* kb);
-    void render(SDL_Renderer* r, int camX, int camY, float renderScale = 1.0f);
-};
\ No newline at end of file
+    // Rendering lives in PlayerRender.cpp (game target only)
+    void render(SDL_Renderer* r, int camX, int camY, float renderScale = 1.0f, float alpha = 1.0f);
+
+    // Fixed-timestep interpolation: call before each tick, then render with alpha
+    void storePrevious();
+    float renderX(float alpha) const;
+    float renderY(float alpha) const;
+};
@@ -0,0 +1,58 @@
+#pragma once
+#include "Player.h"
+#include "ActorStore.h"
+#include <cstdint>
+
+class FrameProfiler;
+
+class Level;
+
+// Headless gameplay step: one fixed tick of player physics, tile collisions,
+// level bounds and win/lose checks. No window or renderer required.
+class Simulation {
+public:
+    Simulation(Level& level, Player& player, int cellSize = 32);
+
+    // Advance one tick of dt seconds with the given input
+    void tick(const PlayerInput& input, double dt);
+
+    // While paused (editor) ticks only keep interpolation state in sync
+    void setPaused(bool p);
+    bool paused() const;
+
+    // Swept (continuous) tile collision for the player, on by default. Safe at
+    // large dt, e.g. fast-forwarded headless runs; off = push-out only.
+    void setSweptCollision(bool on);
+    bool sweptCollision() const;
+
+    // Optional per-phase timing (player update, collisions, actors)
+    void setProfiler(FrameProfiler* p);
+
+    bool lost() const;
+    bool won() const;
+    bool finished() const;
+
+    // FNV-1a over the gameplay state (player, actors, win/lose), for
+    // checking that a replay reproduces the recorded run
+    uint64_t checksum() const;
+
+    // Enemies/projectiles/platforms, stepped every tick alongside the player
+    ActorStore& actors();
+    const ActorStore& actors() const;
+
+    int cellSize() const;
+    // Level extent in physics pixels
+    int levelWidth() const;
+    int levelHeight() const;
+
+private:
+    Level& level;
+    Player& player;
+    ActorStore actorStore;
+    int cell;
+    bool isPaused;
+    bool swept;
+    FrameProfiler* profiler;
+    bool playerLost;
+    bool playerWon;
+};
@@ -0,0 +1,42 @@
+#pragma once
+#include <SDL.h>
+#include <string>
+#include <vector>
+#include "Player.h"
+
+// Packs sprite frames into as few textures as possible (one page unless
+// they don't fit the renderer's max texture size). Frames are drawn from
+// per-frame source rects, so animating never switches textures or queries
+// the driver for sizes.
+class SpriteAtlas {
+public:
+    SpriteAtlas();
+    ~SpriteAtlas();
+
+    SpriteAtlas(const SpriteAtlas&) = delete;
+    SpriteAtlas& operator=(const SpriteAtlas&) = delete;
+
+    // Register an image file; returns its frame id. Takes effect on build().
+    int add(const std::string& path);
+
+    // Decode all registered images, pack and upload. Calling again re-decodes
+    // (texture reload); frame ids stay the same.
+    bool build(SDL_Renderer* ren, int maxSize = 2048);
+
+    // Region for a frame id (tex null if it failed to load)
+    SpriteFrame frame(int id) const;
+    int frameCount() const;
+    int pageCount() const;
+    bool complete() const; // every registered image is packed
+
+private:
+    struct Entry {
+        std::string path;
+        SpriteFrame region;
+    };
+
+    void destroyPages();
+
+    std::vector<Entry> entries;
+    std::vector<SDL_Texture*> pages;
+};
@@ -0,0 +1,106 @@
+#pragma once
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Text drawing for one font/size.
+// Glyphs are rasterized once into an atlas texture (UTF-8 aware, printable
+// ASCII and Polish letters preloaded, anything else added on first use) and strings are
+// drawn as textured quads, so changing text costs no surface/texture churn.
+// Without the atlas (glyphAtlas = false) the renderer only backs CachedText
+// labels and measure(); draw() does nothing.
+class TextRenderer {
+public:
+    TextRenderer(SDL_Renderer* renderer, const std::string& fontPath, int ptSize, bool glyphAtlas = true);
+    ~TextRenderer();
+
+    TextRenderer(const TextRenderer&) = delete;
+    TextRenderer& operator=(const TextRenderer&) = delete;
+
+    bool ok() const;
+    TTF_Font* font() const;
+    SDL_Renderer* renderer() const;
+    int lineHeight() const;
+    // GPU bytes held by the glyph atlas
+    size_t textureBytes() const;
+
+    // Draw UTF-8 text with its top-left at (x, y); '\n' starts a new line
+    void draw(const std::string& utf8, int x, int y, SDL_Color color);
+    // Size of the text as draw() would lay it out
+    void measure(const std::string& utf8, int* w, int* h);
+
+    // Decode one UTF-8 code point at s[i], advancing i (U+FFFD on bad input)
+    static uint32_t nextCodepoint(const std::string& s, size_t& i);
+
+private:
+    struct Glyph {
+        SDL_Rect src{0, 0, 0, 0};
+        int advance = 0;
+        bool valid = false;
+    };
+
+    const Glyph& glyph(uint32_t cp);
+    bool addGlyph(uint32_t cp, Glyph& g);
+    bool createAtlas();
+
+    SDL_Renderer* ren;
+    TTF_Font* fnt;
+    bool useAtlas;
+    SDL_Texture* atlas;
+    int atlasW;
+    int atlasH;
+    // shelf packer state
+    int penX;
+    int penY;
+    int shelfH;
+
+    Glyph ascii[128];
+    std::unordered_map<uint32_t, Glyph> glyphs;
+
+    std::vector<SDL_Vertex> verts;
+    std::vector<int> indices;
+};
+
+// A whole string rendered once to a texture and re-rendered only when the
+// text or colour changes. For labels and values that change rarely.
+class CachedText {
+public:
+    explicit CachedText(TextRenderer* text = nullptr, SDL_Color color = {255, 255, 255, 255});
+    ~CachedText();
+
+    CachedText(CachedText&& other) noexcept;
+    CachedText& operator=(CachedText&& other) noexcept;
+    CachedText(const CachedText&) = delete;
+    CachedText& operator=(const CachedText&) = delete;
+
+    void setRenderer(TextRenderer* text);
+    // Returns true when the texture had to be re-rendered
+    bool set(const std::string& utf8);
+    void setColor(SDL_Color color);
+
+    void draw(int x, int y) const;
+
+    const std::string& text() const;
+    SDL_Texture* texture() const;
+    int width() const;
+    int height() const;
+    size_t bytes() const;
+
+    // Drop the texture but keep the text; reload() renders it again
+    void unload();
+    void reload();
+
+private:
+    void rebuild();
+    void release();
+
+    TextRenderer* owner;
+    std::string str;
+    SDL_Color col;
+    SDL_Texture* tex;
+    int w;
+    int h;
+};
@@ -1,13 +1,63 @@
 #pragma once
 #include <SDL.h>
+#include <cstddef>
 #include <string>
+#include <vector>
+
+// Load-time preprocessing for images shown smaller than they are stored
+// (level backgrounds). Level 0 is resampled down to maxHeight rows (aspect
+// kept, never enlarged); mipLevels > 1 adds successively halved copies so a
+// smaller output can switch level instead of re-decoding. Mips are only made
+// when level 0 was shrunk (a source no taller than the display has nothing
+// smaller to show) and only while they stay minMipHeight rows or taller.
+struct TextureFit {
+    int maxHeight = 0; // 0 = upload as decoded
+    int mipLevels = 1;
+    int minMipHeight = 0; // shortest mip worth keeping
+
+    bool operator==(const TextureFit& o) const {
+        return maxHeight == o.maxHeight && mipLevels == o.mipLevels && minMipHeight == o.minMipHeight;
+    }
+    bool operator!=(const TextureFit& o) const { return !(*this == o); }
+};
 
 class Texture {
 public:
+    // Selected level; w/h are its size
     SDL_Texture* tex = nullptr;
     int w = 0, h = 0;
     Texture() = default;
     ~Texture();
-    bool load(SDL_Renderer* r, const std::string& path);
+    bool load(SDL_Renderer* r, const std::string& path, const TextureFit& fit = TextureFit());
     void draw(SDL_Renderer* r, int x, int y, int w_ = -1, int h_ = -1);
-};
\ No newline at end of file
+
+    // Decode + convert to RGBA32 without touching the renderer, so it can run
+    // on a worker thread. Caller frees the surface; null on failure.
+    static SDL_Surface* decode(const std::string& path);
+    // decode() plus resampling/mips per fit (also worker-safe). Caller frees
+    // every surface in levels; false on failure.
+    static bool decode(const std::string& path, const TextureFit& fit, std::vector<SDL_Surface*>& levels);
+    // Upload a decoded surface (render thread). Does not free surf.
+    bool upload(SDL_Renderer* r, SDL_Surface* surf, const std::string& path);
+    // Upload a mip chain, largest first (render thread). Does not free them.
+    bool upload(SDL_Renderer* r, const std::vector<SDL_Surface*>& levels, const std::string& path);
+
+    // Switch tex to the smallest level at least displayHeight tall (the
+    // largest level if none is); true when tex changed
+    bool selectLevel(int displayHeight);
+    int levelCount() const;
+    // Estimated GPU bytes across all levels (w * h * 4)
+    size_t bytes() const;
+
+    // Destroy the GPU copies (tex becomes null); load() brings them back
+    void unload();
+
+private:
+    struct Level {
+        SDL_Texture* tex;
+        int w;
+        int h;
+    };
+
+    std::vector<Level> levels; // owned, largest first; tex is one of them
+};
@@ -0,0 +1,89 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Accounting and budget for GPU texture memory.
+// Owners (AssetCache, Menu) register each texture with its byte size and
+// two callbacks: evict (destroy the GPU copy, keep what's needed to rebuild
+// it) and reload (rebuild it, returning the new size). When the resident
+// total exceeds the budget, the least recently used textures that weren't
+// used this frame and aren't pinned are evicted. Owners call use() before
+// drawing, which brings an evicted texture back.
+class TextureResidency {
+public:
+    struct Stats {
+        size_t budget = 0;        // 0 = unlimited
+        size_t residentBytes = 0;
+        size_t peakBytes = 0;
+        int resident = 0;
+        int evicted = 0;
+        int pinned = 0;
+        uint64_t evictions = 0;
+        uint64_t reloads = 0;
+        uint64_t reloadFailures = 0;
+    };
+
+    using EvictFn = std::function<void()>;
+    // Returns the reloaded size in bytes, 0 on failure
+    using ReloadFn = std::function<size_t()>;
+    // Optional veto, e.g. someone still holds a raw pointer to the texture
+    using CanEvictFn = std::function<bool()>;
+
+    explicit TextureResidency(size_t budgetBytes = 0);
+
+    TextureResidency(const TextureResidency&) = delete;
+    TextureResidency& operator=(const TextureResidency&) = delete;
+
+    void setBudget(size_t bytes);
+    size_t budget() const;
+
+    // Register a resident texture; returns its id
+    int track(const std::string& name, size_t bytes, EvictFn evict, ReloadFn reload, CanEvictFn canEvict = nullptr);
+    void untrack(int id);
+    // The owner (re)loaded it itself, e.g. an async upload; counts as a
+    // reload when the texture had been evicted
+    void setResident(int id, size_t bytes);
+    // Pinned textures are counted but never evicted
+    void setPinned(int id, bool pinned);
+
+    // Mark drawn this frame, reloading first if evicted; false if it's not
+    // resident afterwards
+    bool use(int id);
+    bool resident(int id) const;
+
+    // Once per frame: evict down to budget, then advance the LRU clock
+    void endFrame();
+
+    Stats stats() const;
+    void logStats() const;
+
+private:
+    struct Entry {
+        std::string name;
+        size_t bytes = 0;
+        uint64_t lastUse = 0;
+        bool live = false;
+        bool resident = false;
+        bool pinned = false;
+        EvictFn evict;
+        ReloadFn reload;
+        CanEvictFn canEvict;
+    };
+
+    Entry* entry(int id);
+    const Entry* entry(int id) const;
+    void enforce();
+
+    std::vector<Entry> entries;
+    std::vector<int> freeIds;
+    size_t budgetBytes;
+    size_t residentBytes;
+    size_t peakBytes;
+    uint64_t frame;
+    uint64_t evictCount;
+    uint64_t reloadCount;
+    uint64_t reloadFailCount;
+};
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Tile ids stored in a level cell
+enum TileType : uint8_t {
+    TILE_EMPTY = 0,
+    TILE_SOLID = 1,
+    TILE_DAMAGING = 2,
+    TILE_PICKUP = 3,
+    TILE_TYPE_COUNT = 4
+};
+
+// Flat row-major tile storage: one contiguous buffer of 1-byte tile ids.
+// Rows are `stride` bytes apart; capacity grows geometrically in both
+// dimensions so growing the grid one cell at a time is amortized O(1).
+class TileGrid {
+public:
+    using Tile = uint8_t;
+
+    TileGrid();
+    TileGrid(int rows, int cols);
+
+    int rows() const { return nRows; }
+    int cols() const { return nCols; }
+    int stride() const { return capCols; }
+
+    // Reset to rows x cols filled with v (keeps allocation when it fits)
+    void assign(int rows, int cols, Tile v = TILE_EMPTY);
+    // Grow (never shrink) so that (r, c) is a valid cell
+    void ensure(int r, int c);
+    void clear();
+
+    // Out-of-range reads return TILE_EMPTY, out-of-range writes are ignored
+    Tile get(int r, int c) const {
+        if (r < 0 || c < 0 || r >= nRows || c >= nCols) return TILE_EMPTY;
+        return cells[static_cast<size_t>(r) * capCols + c];
+    }
+    void set(int r, int c, Tile v) {
+        if (r < 0 || c < 0 || r >= nRows || c >= nCols) return;
+        cells[static_cast<size_t>(r) * capCols + c] = v;
+    }
+
+    // Direct row access (cols() valid entries), for tight loops
+    Tile* row(int r) { return cells.data() + static_cast<size_t>(r) * capCols; }
+    const Tile* row(int r) const { return cells.data() + static_cast<size_t>(r) * capCols; }
+
+    // Bytes held by the tile buffer
+    size_t memoryBytes() const;
+
+private:
+    void reserve(int rowCap, int colCap);
+
+    std::vector<Tile> cells;
+    int nRows;
+    int nCols;
+    int capRows;
+    int capCols;
+};
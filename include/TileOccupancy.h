@@ -0,0 +1,73 @@
+#pragma once
+#include "ChunkedTileMap.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Broadphase index over a tile map: one bit per cell per tile class
+// (solid, damaging, pickup), 64 cells per word, kept in sync through the
+// map's change listener. Queries over an AABB skip empty words entirely, so
+// cost depends on occupied cells rather than box size.
+//
+// Rebuilds lazily after a reset, on the first query; when the map grows the
+// index is extended in place. Queries are const but not thread-safe (they
+// may trigger that rebuild).
+class TileOccupancy {
+public:
+    // Class masks are bit (1 << TileType)
+    static constexpr uint8_t kSolid = 1u << TILE_SOLID;
+    static constexpr uint8_t kDamaging = 1u << TILE_DAMAGING;
+    static constexpr uint8_t kPickup = 1u << TILE_PICKUP;
+    static constexpr uint8_t kBlocking = kSolid | kDamaging;
+    static constexpr uint8_t kAll = kSolid | kDamaging | kPickup;
+
+    // Occupied cells row, columns [c0, c1] inclusive
+    struct Span {
+        int row;
+        int c0;
+        int c1;
+    };
+
+    TileOccupancy();
+    ~TileOccupancy();
+
+    TileOccupancy(const TileOccupancy&) = delete;
+    TileOccupancy& operator=(const TileOccupancy&) = delete;
+
+    void attach(const ChunkedTileMap* map);
+    void detach();
+
+    bool test(uint8_t mask, int r, int c) const;
+    // Any cell of the mask's classes in rows [r0, r1] x cols [c0, c1]
+    bool any(uint8_t mask, int r0, int c0, int r1, int c1) const;
+    // Append spans of cells matching mask (classes OR'ed) in row-major order;
+    // returns the number appended
+    int query(uint8_t mask, int r0, int c0, int r1, int c1, std::vector<Span>& out) const;
+
+    size_t memoryBytes() const;
+
+private:
+    void onChange(int r, int c, TileGrid::Tile oldValue, TileGrid::Tile newValue);
+    void rebuild() const;
+    // Make room for rows x cols; new cells are empty
+    void grow(int rows, int cols);
+    bool clampBox(int& r0, int& c0, int& r1, int& c1) const;
+    // OR of the mask's class words for one row word
+    uint64_t word(uint8_t mask, int r, int w) const {
+        size_t i = static_cast<size_t>(r) * words + w;
+        uint64_t v = 0;
+        for (int t = TILE_SOLID; t < TILE_TYPE_COUNT; ++t) {
+            if (mask & (1u << t)) v |= bits[t][i];
+        }
+        return v;
+    }
+
+    const ChunkedTileMap* map;
+    int listenerId;
+
+    mutable bool stale;
+    mutable int nRows;
+    mutable int nCols;
+    mutable int words; // 64-bit words per row (may exceed what nCols needs)
+    mutable std::vector<uint64_t> bits[TILE_TYPE_COUNT]; // [TILE_EMPTY] unused
+};
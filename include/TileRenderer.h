@@ -0,0 +1,75 @@
+#pragma once
+#include <SDL.h>
+#include <vector>
+#include "TileGrid.h"
+
+class Level;
+
+// Draws level tiles.
+// Tiles are baked into screen-width render-target chunks once and the 1-2
+// visible chunks are blitted per frame; a chunk is re-baked only when a tile
+// inside it changes (pickup collected, editor click). Without render-target
+// support it falls back to drawing the visible cells directly, grouped by
+// type so each type is one SDL_RenderFillRects call.
+class TileRenderer {
+public:
+    TileRenderer();
+    ~TileRenderer();
+
+    TileRenderer(const TileRenderer&) = delete;
+    TileRenderer& operator=(const TileRenderer&) = delete;
+
+    // Listen for tile changes on the level (detaches from any previous one)
+    void attach(Level* level);
+    void detach();
+
+    // camX is the camera in render pixels, view size and cell size likewise
+    void render(SDL_Renderer* ren, const Level& level, int camX, int viewW, int viewH, int cellW, int cellH);
+
+    // Drop baked chunks (e.g. after SDL_RENDER_TARGETS_RESET)
+    void invalidateAll();
+    // Mark the baked chunk containing cell (r, c) for re-bake
+    void invalidateCell(int r, int c);
+
+    void setBaking(bool enabled);
+
+    // Stats from the last render()
+    int lastDrawCalls() const;
+    int lastTileCount() const;
+    int lastBakes() const;
+
+private:
+    // one bucket per tile type plus one for unknown ids
+    static const int kBuckets = TILE_TYPE_COUNT + 1;
+
+    struct BakedChunk {
+        SDL_Texture* tex = nullptr;
+        bool dirty = true;
+    };
+
+    // Gather tiles of rows [0, lastRow] and columns [firstCol, lastCol] into
+    // the type buckets, positioned relative to originX
+    void collect(const Level& level, int firstCol, int lastCol, int lastRow, int originX, int cellW, int cellH);
+    void submit(SDL_Renderer* ren);
+    void renderDirect(SDL_Renderer* ren, const Level& level, int camX, int viewW, int viewH, int cellW, int cellH);
+    void renderBaked(SDL_Renderer* ren, const Level& level, int camX, int viewW, int viewH, int cellW, int cellH);
+    bool bake(SDL_Renderer* ren, const Level& level, int index, int lastRow);
+    void destroyChunks();
+
+    std::vector<SDL_Rect> batches[kBuckets];
+    std::vector<TileGrid::Tile> rowBuf;
+    int drawCalls;
+    int tileCount;
+    int bakes;
+
+    // baked layer
+    bool baking;
+    std::vector<BakedChunk> chunks; // index = chunk x / chunkW
+    int chunkW;
+    int chunkH;
+    int bakedCellW;
+    int bakedCellH;
+
+    Level* attached;
+    int listenerId;
+};
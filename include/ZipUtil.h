@@ -1,4 +1,20 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <vector>
+
+struct ZipEntry {
+    std::string name;
+    const void* data;
+    size_t size;
+};
+
+// Write entries (deflated) into a new zip, replacing any existing file
+bool writeZip(const std::string& zipPath, const std::vector<ZipEntry>& entries);
+// Read one entry fully into out; false if the zip or entry is missing/corrupt
+// or the entry would unpack to more than maxSize bytes
+bool readZipEntry(const std::string& zipPath, const std::string& name, std::vector<uint8_t>& out,
+                  size_t maxSize = 256u << 20);
 
 bool saveLevelZip(const std::string& zipPath, const std::string& layout, const std::string& assets);
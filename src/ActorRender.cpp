@@ -0,0 +1,39 @@
+#include "ActorRender.h"
+#include "ActorStore.h"
+#include <vector>
+
+void renderActors(SDL_Renderer* r, const ActorStore& actors, int camX, int camY, float renderScale, float alpha) {
+    if (!r || actors.aliveCount() == 0) return;
+
+    static const SDL_Color kKindColors[ACTOR_KIND_COUNT] = {
+        {200, 60, 200, 255}, // enemy
+        {255, 140, 0, 255},  // projectile
+        {60, 140, 220, 255}, // platform
+    };
+
+    // scratch kept across frames: no per-frame allocation once warmed up
+    static std::vector<SDL_Rect> batches[ACTOR_KIND_COUNT];
+    for (auto& b : batches) b.clear();
+
+    int viewW = 0, viewH = 0;
+    SDL_RenderGetLogicalSize(r, &viewW, &viewH);
+    if (viewW <= 0 || viewH <= 0) SDL_GetRendererOutputSize(r, &viewW, &viewH);
+
+    const int n = actors.size();
+    for (int i = 0; i < n; ++i) {
+        if (!(actors.flags[i] & ACTOR_ALIVE) || actors.kind[i] >= ACTOR_KIND_COUNT) continue;
+        float ax = actors.renderX(i, alpha);
+        float ay = actors.renderY(i, alpha) - actors.h[i]; // y is feet
+        SDL_Rect dst{ static_cast<int>((ax - camX) * renderScale + 0.5f), static_cast<int>((ay - camY) * renderScale + 0.5f),
+                      static_cast<int>(actors.w[i] * renderScale + 0.5f), static_cast<int>(actors.h[i] * renderScale + 0.5f) };
+        if (dst.x + dst.w < 0 || dst.y + dst.h < 0 || dst.x > viewW || dst.y > viewH) continue;
+        batches[actors.kind[i]].push_back(dst);
+    }
+
+    for (int k = 0; k < ACTOR_KIND_COUNT; ++k) {
+        if (batches[k].empty()) continue;
+        const SDL_Color& c = kKindColors[k];
+        SDL_SetRenderDrawColor(r, c.r, c.g, c.b, c.a);
+        SDL_RenderFillRects(r, batches[k].data(), static_cast<int>(batches[k].size()));
+    }
+}
@@ -0,0 +1,198 @@
+#include "ActorStore.h"
+#include "Level.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+void ActorStore::reserve(size_t n) {
+    for (auto* col : { &x, &y, &prevX, &prevY, &vx, &vy, &w, &h, &gravity, &animTime, &animDelay }) col->reserve(n);
+    flags.reserve(n);
+    kind.reserve(n);
+    animFrame.reserve(n);
+    animFrames.reserve(n);
+}
+
+void ActorStore::clear() {
+    resizeColumns(0);
+    alive = 0;
+}
+
+void ActorStore::resizeColumns(size_t n) {
+    for (auto* col : { &x, &y, &prevX, &prevY, &vx, &vy, &w, &h, &gravity, &animTime, &animDelay }) col->resize(n);
+    flags.resize(n);
+    kind.resize(n);
+    animFrame.resize(n);
+    animFrames.resize(n);
+}
+
+int ActorStore::spawn(const ActorDesc& d) {
+    size_t i = x.size();
+    resizeColumns(i + 1);
+    x[i] = prevX[i] = d.x;
+    y[i] = prevY[i] = d.y;
+    vx[i] = d.vx;
+    vy[i] = d.vy;
+    w[i] = d.w;
+    h[i] = d.h;
+    gravity[i] = d.gravity;
+    flags[i] = static_cast<uint8_t>(d.flags | ACTOR_ALIVE);
+    kind[i] = d.kind;
+    animTime[i] = 0.f;
+    animDelay[i] = d.frameDelay;
+    animFrame[i] = 0;
+    animFrames[i] = std::max<uint16_t>(1, d.frameCount);
+    ++alive;
+    return static_cast<int>(i);
+}
+
+void ActorStore::kill(int i) {
+    if (i < 0 || i >= size() || !(flags[i] & ACTOR_ALIVE)) return;
+    flags[i] = 0;
+    vx[i] = vy[i] = 0.f;
+    gravity[i] = 0.f; // dead actors stay inert in the kernels until compacted
+    --alive;
+}
+
+void ActorStore::moveActor(size_t from, size_t to) {
+    for (auto* col : { &x, &y, &prevX, &prevY, &vx, &vy, &w, &h, &gravity, &animTime, &animDelay }) (*col)[to] = (*col)[from];
+    flags[to] = flags[from];
+    kind[to] = kind[from];
+    animFrame[to] = animFrame[from];
+    animFrames[to] = animFrames[from];
+}
+
+int ActorStore::compact() {
+    size_t n = x.size();
+    size_t i = 0;
+    while (i < n) {
+        if (flags[i] & ACTOR_ALIVE) {
+            ++i;
+            continue;
+        }
+        --n;
+        if (i != n) moveActor(n, i);
+    }
+    int removed = size() - static_cast<int>(n);
+    resizeColumns(n);
+    return removed;
+}
+
+void ActorStore::storePrevious() {
+    if (x.empty()) return;
+    std::memcpy(prevX.data(), x.data(), x.size() * sizeof(float));
+    std::memcpy(prevY.data(), y.data(), y.size() * sizeof(float));
+}
+
+void ActorStore::integrate(float dt, float worldGravity, float maxFallSpeed) {
+    const size_t n = x.size();
+    float* px = x.data();
+    float* py = y.data();
+    float* pvx = vx.data();
+    float* pvy = vy.data();
+    const float* pg = gravity.data();
+    const float g = worldGravity * dt;
+
+    // branch-free so it vectorizes; dead actors have zero velocity and gravity
+    for (size_t i = 0; i < n; ++i) {
+        float v = pvy[i] + g * pg[i];
+        pvy[i] = v < maxFallSpeed ? v : maxFallSpeed;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        px[i] += pvx[i] * dt;
+        py[i] += pvy[i] * dt;
+    }
+}
+
+void ActorStore::animate(float dt) {
+    const size_t n = x.size();
+    const float ms = dt * 1000.f;
+    for (size_t i = 0; i < n; ++i) {
+        // same rule as Player: advance while moving, rest on frame 0
+        if (vx[i] == 0.f) {
+            animTime[i] = 0.f;
+            animFrame[i] = 0;
+            continue;
+        }
+        animTime[i] += ms;
+        if (animTime[i] >= animDelay[i]) {
+            animTime[i] = 0.f;
+            animFrame[i] = static_cast<uint16_t>((animFrame[i] + 1) % animFrames[i]);
+        }
+    }
+}
+
+int ActorStore::killOutside(float minX, float minY, float maxX, float maxY) {
+    int killed = 0;
+    const int n = size();
+    for (int i = 0; i < n; ++i) {
+        if (!(flags[i] & ACTOR_ALIVE)) continue;
+        if (x[i] + w[i] < minX || x[i] > maxX || y[i] < minY || y[i] - h[i] > maxY) {
+            kill(i);
+            ++killed;
+        }
+    }
+    return killed;
+}
+
+void ActorStore::resolveTiles(Level& level, int cellSize) {
+    if (cellSize <= 0 || level.rows() <= 0 || level.cols() <= 0) return;
+    const float cell = static_cast<float>(cellSize);
+    const float inv = 1.0f / cell;
+    const float eps = 0.0001f;
+    const TileOccupancy& occ = level.occupancy;
+
+    const size_t n = x.size();
+    for (size_t i = 0; i < n; ++i) {
+        uint8_t f = flags[i];
+        if ((f & (ACTOR_ALIVE | ACTOR_COLLIDES)) != (ACTOR_ALIVE | ACTOR_COLLIDES)) continue;
+
+        float left = x[i];
+        float top = y[i] - h[i];
+        int c0 = static_cast<int>(std::floor(left * inv));
+        int c1 = static_cast<int>(std::floor((left + w[i] - eps) * inv));
+        int r0 = static_cast<int>(std::floor(top * inv));
+        int r1 = static_cast<int>(std::floor((top + h[i] - eps) * inv));
+
+        f &= static_cast<uint8_t>(~ACTOR_ON_GROUND);
+        spans.clear();
+        if (occ.query(TileOccupancy::kBlocking, r0, c0, r1, c1, spans) == 0) {
+            flags[i] = f;
+            continue;
+        }
+        if (f & ACTOR_DIE_ON_HIT) {
+            flags[i] = f;
+            kill(static_cast<int>(i));
+            continue;
+        }
+
+        // same minimum-penetration push-out as the player, per occupied cell
+        for (const TileOccupancy::Span& s : spans) {
+            float ty = s.row * cell;
+            for (int c = s.c0; c <= s.c1; ++c) {
+                float tx = c * cell;
+                float ix = std::min(left + w[i], tx + cell) - std::max(left, tx);
+                float iy = std::min(top + h[i], ty + cell) - std::max(top, ty);
+                if (ix <= 0.f || iy <= 0.f) continue;
+                if (ix < iy) {
+                    bool fromLeft = left + w[i] * 0.5f < tx + cell * 0.5f;
+                    left += fromLeft ? -ix : ix;
+                    if ((f & ACTOR_TURN_AT_WALL) && ((fromLeft && vx[i] > 0.f) || (!fromLeft && vx[i] < 0.f))) {
+                        vx[i] = -vx[i];
+                    }
+                } else if (top + h[i] * 0.5f < ty + cell * 0.5f) {
+                    top = ty - h[i];
+                    if (vy[i] > 0.f) vy[i] = 0.f;
+                    f |= ACTOR_ON_GROUND;
+                } else {
+                    top += iy;
+                    if (vy[i] < 0.f) vy[i] = 0.f;
+                }
+            }
+        }
+        if (vx[i] < 0.f) f |= ACTOR_FACING_LEFT;
+        else if (vx[i] > 0.f) f &= static_cast<uint8_t>(~ACTOR_FACING_LEFT);
+        flags[i] = f;
+        x[i] = left;
+        y[i] = top + h[i];
+    }
+}
@@ -0,0 +1,207 @@
+#include "AssetArchive.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+uint32_t readU32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint64_t readU64(const uint8_t* p) {
+    return static_cast<uint64_t>(readU32(p)) | (static_cast<uint64_t>(readU32(p + 4)) << 32);
+}
+
+// mounted archive; written once at startup, then only read (also from the decode worker)
+AssetArchive g_mounted;
+std::string g_rootPrefix;
+}
+
+AssetArchive::AssetArchive()
+    : base(nullptr)
+    , length(0)
+#ifdef _WIN32
+    , fileHandle(nullptr)
+    , mapHandle(nullptr)
+#else
+    , fd(-1)
+#endif
+{
+}
+
+AssetArchive::~AssetArchive() {
+    close();
+}
+
+bool AssetArchive::open(const std::string& path) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER sz;
+    if (!GetFileSizeEx(file, &sz) || sz.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mapHandle = mapping;
+    base = static_cast<const uint8_t*>(view);
+    length = static_cast<size_t>(sz.QuadPart);
+#else
+    int f = ::open(path.c_str(), O_RDONLY);
+    if (f < 0) return false;
+    struct stat st;
+    if (fstat(f, &st) != 0 || st.st_size == 0) {
+        ::close(f);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, f, 0);
+    if (view == MAP_FAILED) {
+        ::close(f);
+        return false;
+    }
+    fd = f;
+    base = static_cast<const uint8_t*>(view);
+    length = static_cast<size_t>(st.st_size);
+#endif
+
+    if (!parseIndex()) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "AssetArchive: %s is not a valid archive", path.c_str());
+        close();
+        return false;
+    }
+    SDL_Log("DBG: asset archive %s mapped (%u entries, %u bytes)", path.c_str(),
+            static_cast<unsigned>(index.size()), static_cast<unsigned>(length));
+    return true;
+}
+
+void AssetArchive::close() {
+#ifdef _WIN32
+    if (base) UnmapViewOfFile(base);
+    if (mapHandle) CloseHandle(static_cast<HANDLE>(mapHandle));
+    if (fileHandle) CloseHandle(static_cast<HANDLE>(fileHandle));
+    fileHandle = mapHandle = nullptr;
+#else
+    if (base) munmap(const_cast<uint8_t*>(base), length);
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+#endif
+    base = nullptr;
+    length = 0;
+    index.clear();
+}
+
+bool AssetArchive::isOpen() const {
+    return base != nullptr;
+}
+
+const uint8_t* AssetArchive::find(const std::string& name, size_t* size) const {
+    if (!base) return nullptr;
+    uint64_t h = hash(name.data(), name.size());
+    auto it = std::lower_bound(index.begin(), index.end(), h,
+                               [](const Entry& e, uint64_t key) { return e.nameHash < key; });
+    for (; it != index.end() && it->nameHash == h; ++it) {
+        if (it->name != name) continue; // hash collision
+        if (size) *size = static_cast<size_t>(it->size);
+        return base + it->offset;
+    }
+    return nullptr;
+}
+
+SDL_RWops* AssetArchive::openRW(const std::string& name) const {
+    size_t size = 0;
+    const uint8_t* data = find(name, &size);
+    if (!data) return nullptr;
+    return SDL_RWFromConstMem(data, static_cast<int>(size));
+}
+
+const std::vector<AssetArchive::Entry>& AssetArchive::entries() const {
+    return index;
+}
+
+bool AssetArchive::verify() const {
+    for (const Entry& e : index) {
+        if (hash(base + e.offset, static_cast<size_t>(e.size)) != e.dataHash) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "AssetArchive: %s is corrupt", e.name.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t AssetArchive::hash(const void* data, size_t len) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    uint64_t h = 14695981039346656037ULL;
+    for (size_t i = 0; i < len; ++i) {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+bool AssetArchive::mount(const std::string& archivePath, const std::string& rootPrefix) {
+    g_rootPrefix = rootPrefix;
+    return g_mounted.open(archivePath);
+}
+
+void AssetArchive::unmount() {
+    g_mounted.close();
+    g_rootPrefix.clear();
+}
+
+SDL_RWops* AssetArchive::openFile(const std::string& path) {
+    if (g_mounted.isOpen() && path.compare(0, g_rootPrefix.size(), g_rootPrefix) == 0) {
+        SDL_RWops* rw = g_mounted.openRW(path.substr(g_rootPrefix.size()));
+        if (rw) return rw;
+    }
+    return SDL_RWFromFile(path.c_str(), "rb");
+}
+
+bool AssetArchive::parseIndex() {
+    if (length < kHeaderBytes) return false;
+    if (readU32(base) != kMagic || readU32(base + 4) != kVersion) return false;
+    uint32_t count = readU32(base + 8);
+
+    index.clear();
+    index.reserve(count);
+    size_t pos = kHeaderBytes;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (pos + 34 > length) return false;
+        Entry e;
+        e.nameHash = readU64(base + pos);
+        e.offset = readU64(base + pos + 8);
+        e.size = readU64(base + pos + 16);
+        e.dataHash = readU64(base + pos + 24);
+        size_t nameLen = static_cast<size_t>(base[pos + 32]) | (static_cast<size_t>(base[pos + 33]) << 8);
+        pos += 34;
+        if (pos + nameLen > length) return false;
+        e.name.assign(reinterpret_cast<const char*>(base + pos), nameLen);
+        pos += nameLen;
+        if (e.offset > length || e.size > length - e.offset) return false;
+        index.push_back(std::move(e));
+    }
+    return std::is_sorted(index.begin(), index.end(),
+                          [](const Entry& a, const Entry& b) { return a.nameHash < b.nameHash; });
+}
@@ -0,0 +1,214 @@
+#include "AssetCache.h"
+#include "Texture.h"
+#include "TextureResidency.h"
+
+AssetCache::AssetCache(SDL_Renderer* renderer, TextureResidency* residency)
+    : ren(renderer)
+    , budget(residency)
+    , hitCount(0)
+    , missCount(0)
+    , failCount(0)
+{
+}
+
+AssetCache::~AssetCache() {
+    clear();
+}
+
+void AssetCache::setFit(const std::string& path, const TextureFit& fit) {
+    fits[path] = fit;
+}
+
+TextureFit AssetCache::fitFor(const std::string& path) const {
+    auto it = fits.find(path);
+    return it != fits.end() ? it->second : TextureFit();
+}
+
+void AssetCache::loaded(const std::string& path, const std::shared_ptr<Texture>& tex) {
+    if (!budget) return;
+    auto id = residencyIds.find(path);
+    if (id != residencyIds.end()) {
+        budget->setResident(id->second, tex->bytes());
+        return;
+    }
+    Texture* raw = tex.get();
+    std::weak_ptr<Texture> weak = tex;
+    residencyIds[path] = budget->track(
+        path, tex->bytes(),
+        [raw]() { raw->unload(); },
+        [this, path]() -> size_t {
+            auto it = textures.find(path);
+            if (it == textures.end() || !it->second->load(ren, path, fitFor(path))) return 0;
+            return it->second->bytes();
+        },
+        // a handle outside the cache may have handed tex to a renderer-side
+        // holder (Background, sprite frames), so only cache-only entries go
+        [weak]() { return weak.use_count() == 1; });
+}
+
+void AssetCache::forget(const std::string& path) {
+    auto id = residencyIds.find(path);
+    if (id == residencyIds.end()) return;
+    budget->untrack(id->second);
+    residencyIds.erase(id);
+}
+
+bool AssetCache::touch(const std::string& path) {
+    auto id = residencyIds.find(path);
+    return id == residencyIds.end() || budget->use(id->second);
+}
+
+bool AssetCache::evicted(const std::string& path) const {
+    auto id = residencyIds.find(path);
+    return id != residencyIds.end() && !budget->resident(id->second);
+}
+
+std::shared_ptr<Texture> AssetCache::texture(const std::string& path) {
+    auto it = textures.find(path);
+    if (it != textures.end()) {
+        ++hitCount;
+        // still decoding in the background: block on just that image;
+        // evicted: touch() reloads it
+        bool ok = loader.pending(path) && !it->second->tex ? finishPending(path, *it->second) : touch(path);
+        if (!ok || !it->second->tex) {
+            forget(path);
+            textures.erase(it);
+            return nullptr;
+        }
+        return it->second;
+    }
+
+    ++missCount;
+    std::shared_ptr<Texture> tex = std::make_shared<Texture>();
+    if (!tex->load(ren, path, fitFor(path))) {
+        // failures aren't cached so a fixed file can be picked up later
+        ++failCount;
+        return nullptr;
+    }
+    textures.emplace(path, tex);
+    loaded(path, tex);
+    return tex;
+}
+
+std::shared_ptr<Texture> AssetCache::reload(const std::string& path) {
+    auto it = textures.find(path);
+    if (it == textures.end()) return texture(path);
+
+    ++missCount;
+    if (!it->second->load(ren, path, fitFor(path))) {
+        ++failCount;
+        forget(path);
+        textures.erase(it);
+        return nullptr;
+    }
+    loaded(path, it->second);
+    return it->second;
+}
+
+std::shared_ptr<Texture> AssetCache::textureAsync(const std::string& path) {
+    auto it = textures.find(path);
+    if (it != textures.end()) {
+        ++hitCount;
+        if (evicted(path)) loader.request(path, fitFor(path)); // back in the background
+        else if (it->second->tex) touch(path);
+        return it->second;
+    }
+
+    ++missCount;
+    std::shared_ptr<Texture> tex = std::make_shared<Texture>();
+    textures.emplace(path, tex);
+    loader.request(path, fitFor(path));
+    return tex;
+}
+
+void AssetCache::prefetch(const std::string& path) {
+    textureAsync(path);
+}
+
+bool AssetCache::ready(const std::string& path) const {
+    auto it = textures.find(path);
+    return it != textures.end() && it->second->tex != nullptr;
+}
+
+int AssetCache::pump(int maxUploads) {
+    int uploaded = 0;
+    std::string path;
+    std::vector<SDL_Surface*> levels;
+    while (uploaded < maxUploads && loader.poll(path, levels)) {
+        auto it = textures.find(path);
+        if (levels.empty()) {
+            ++failCount;
+            if (it != textures.end() && !it->second->tex) {
+                forget(path);
+                textures.erase(it);
+            }
+            continue;
+        }
+        if (it != textures.end() && !it->second->tex) {
+            if (it->second->upload(ren, levels, path)) loaded(path, it->second);
+            ++uploaded;
+        }
+        for (SDL_Surface* surf : levels) SDL_FreeSurface(surf);
+    }
+    return uploaded;
+}
+
+bool AssetCache::finishPending(const std::string& path, Texture& tex) {
+    std::vector<SDL_Surface*> levels;
+    if (!loader.take(path, levels)) return false;
+    if (levels.empty()) {
+        ++failCount;
+        return false;
+    }
+    bool ok = tex.upload(ren, levels, path);
+    for (SDL_Surface* surf : levels) SDL_FreeSurface(surf);
+    if (ok) loaded(path, textures[path]);
+    return ok;
+}
+
+bool AssetCache::contains(const std::string& path) const {
+    return textures.find(path) != textures.end();
+}
+
+void AssetCache::purgeUnused() {
+    for (auto it = textures.begin(); it != textures.end();) {
+        // keep in-flight prefetches so their decode isn't wasted
+        bool inFlight = !it->second->tex && loader.pending(it->first);
+        if (it->second.use_count() == 1 && !inFlight) {
+            forget(it->first);
+            it = textures.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void AssetCache::clear() {
+    for (const auto& kv : residencyIds) budget->untrack(kv.second);
+    residencyIds.clear();
+    textures.clear();
+}
+
+AssetCache::Stats AssetCache::stats() const {
+    Stats s;
+    s.hits = hitCount;
+    s.misses = missCount;
+    s.failures = failCount;
+    s.textures = static_cast<int>(textures.size());
+    s.pending = loader.pendingCount();
+    for (const auto& kv : textures) {
+        if (kv.second) s.bytesResident += kv.second->bytes();
+    }
+    return s;
+}
+
+void AssetCache::logStats() const {
+    Stats s = stats();
+    SDL_Log("DBG: assets: %d textures (%d pending), %.1f MB resident, %llu hits, %llu misses, %llu failures",
+            s.textures, s.pending, s.bytesResident / (1024.0 * 1024.0),
+            (unsigned long long)s.hits, (unsigned long long)s.misses, (unsigned long long)s.failures);
+}
+
+TextureResidency* AssetCache::residency() const {
+    return budget;
+}
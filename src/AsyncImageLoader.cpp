@@ -0,0 +1,105 @@
+#include "AsyncImageLoader.h"
+#include "Texture.h"
+#include <algorithm>
+
+AsyncImageLoader::AsyncImageLoader()
+    : stopping(false)
+{
+    worker = std::thread(&AsyncImageLoader::run, this);
+}
+
+AsyncImageLoader::~AsyncImageLoader() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+        queue.clear();
+    }
+    wake.notify_all();
+    if (worker.joinable()) worker.join();
+
+    for (auto& kv : done) {
+        for (SDL_Surface* surf : kv.second) SDL_FreeSurface(surf);
+    }
+}
+
+void AsyncImageLoader::request(const std::string& path, const TextureFit& fit) {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (inFlight.count(path) || done.count(path)) return;
+        inFlight.insert(path);
+        queue.push_back(Job{ path, fit });
+    }
+    wake.notify_one();
+}
+
+bool AsyncImageLoader::pending(const std::string& path) const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return inFlight.count(path) != 0 || done.count(path) != 0;
+}
+
+int AsyncImageLoader::pendingCount() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return static_cast<int>(inFlight.size() + done.size());
+}
+
+bool AsyncImageLoader::poll(std::string& path, std::vector<SDL_Surface*>& levels) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (doneOrder.empty()) return false;
+    path = doneOrder.front();
+    doneOrder.pop_front();
+    auto it = done.find(path);
+    levels = std::move(it->second);
+    done.erase(it);
+    return true;
+}
+
+bool AsyncImageLoader::take(const std::string& path, std::vector<SDL_Surface*>& levels) {
+    std::unique_lock<std::mutex> lock(mtx);
+
+    auto queued = std::find_if(queue.begin(), queue.end(), [&](const Job& j) { return j.path == path; });
+    if (queued != queue.end()) {
+        // not started yet: cheaper to decode right here than to wait in line
+        Job job = *queued;
+        queue.erase(queued);
+        lock.unlock();
+        Texture::decode(job.path, job.fit, levels);
+        lock.lock();
+        inFlight.erase(path);
+        return true;
+    }
+
+    if (inFlight.count(path)) {
+        doneCv.wait(lock, [&] { return done.count(path) != 0 || stopping; });
+    }
+
+    auto it = done.find(path);
+    if (it == done.end()) return false;
+    levels = std::move(it->second);
+    done.erase(it);
+    doneOrder.erase(std::remove(doneOrder.begin(), doneOrder.end(), path), doneOrder.end());
+    return true;
+}
+
+void AsyncImageLoader::run() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            wake.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping) return;
+            job = queue.front();
+            queue.pop_front();
+        }
+
+        std::vector<SDL_Surface*> levels;
+        Texture::decode(job.path, job.fit, levels);
+
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            inFlight.erase(job.path);
+            done[job.path] = std::move(levels);
+            doneOrder.push_back(job.path);
+        }
+        doneCv.notify_all();
+    }
+}
@@ -0,0 +1,207 @@
+#include "Background.h"
+#include <SDL.h>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+namespace {
+// keep a repeating offset within [0, width)
+float wrap(float offset, int width) {
+    if (width <= 0) return 0.0f;
+    offset = std::fmod(offset, static_cast<float>(width));
+    if (offset < 0.0f) offset += static_cast<float>(width);
+    return offset;
+}
+}
+
+Background::Background()
+    : frameWidth(800)
+    , frameHeight(600)
+{
+}
+
+Background::~Background() = default;
+
+int Background::addLayer(SDL_Texture* tex, float parallax, bool repeat, float maxSpeed) {
+    layers.emplace_back();
+    Layer& l = layers.back();
+    l.tex = tex;
+    l.repeat = repeat;
+    l.maxSpeed = maxSpeed;
+    l.parallax = std::max(0.0f, std::min(1.0f, parallax));
+    refreshMetrics(l);
+    return static_cast<int>(layers.size()) - 1;
+}
+
+void Background::clearLayers() {
+    layers.clear();
+}
+
+int Background::layerCount() const {
+    return static_cast<int>(layers.size());
+}
+
+Background::Layer* Background::layer(int i) {
+    if (i < 0 || i >= static_cast<int>(layers.size())) return nullptr;
+    return &layers[i];
+}
+
+Background::Layer& Background::baseLayer() {
+    if (layers.empty()) {
+        // the single-layer defaults this class always had
+        layers.emplace_back();
+        layers.back().scrollSpeed = 100.0f;
+    }
+    return layers.front();
+}
+
+void Background::setLayerTexture(int i, SDL_Texture* tex) {
+    Layer* l = layer(i);
+    if (!l) return;
+    l->tex = tex;
+    refreshMetrics(*l);
+    l->prevCamValid = false; // force snap next time camera update runs
+}
+
+void Background::setLayerParallax(int i, float factor) {
+    if (Layer* l = layer(i)) l->parallax = std::max(0.0f, std::min(1.0f, factor));
+}
+
+void Background::setLayerRepeat(int i, bool repeat) {
+    if (Layer* l = layer(i)) l->repeat = repeat;
+}
+
+void Background::setLayerScrollSpeed(int i, float speed) {
+    if (Layer* l = layer(i)) l->scrollSpeed = speed;
+}
+
+void Background::setLayerMaxSpeed(int i, float pxPerSec) {
+    if (Layer* l = layer(i)) l->maxSpeed = pxPerSec;
+}
+
+void Background::setTexture(SDL_Texture* tex) {
+    baseLayer();
+    setLayerTexture(0, tex);
+}
+
+void Background::setRepeat(bool repeat) {
+    baseLayer().repeat = repeat;
+}
+
+void Background::setFrameSize(int width, int height) {
+    frameWidth = width;
+    frameHeight = height;
+    for (Layer& l : layers) {
+        refreshMetrics(l);
+        l.prevCamValid = false; // frame size change may change mapping; snap
+    }
+}
+
+void Background::setScrollSpeed(float speed) {
+    baseLayer().scrollSpeed = speed;
+}
+
+void Background::setParallax(float factor) {
+    baseLayer();
+    setLayerParallax(0, factor);
+}
+
+void Background::setMaxSpeed(float pxPerSec) {
+    baseLayer().maxSpeed = pxPerSec;
+}
+
+int Background::getFrameWidth() const {
+    return frameWidth;
+}
+
+int Background::getFrameHeight() const {
+    return frameHeight;
+}
+
+void Background::refreshMetrics(Layer& l) {
+    l.texW = l.texH = 0;
+    l.scaledW = 0;
+    l.maxOffset = 0;
+    if (!l.tex || SDL_QueryTexture(l.tex, nullptr, nullptr, &l.texW, &l.texH) != 0 || l.texH <= 0) return;
+
+    // layers are scaled to the frame height
+    float scale = static_cast<float>(frameHeight) / static_cast<float>(l.texH);
+    l.scaledW = std::max(0, static_cast<int>(l.texW * scale));
+    l.maxOffset = std::max(0, l.scaledW - frameWidth);
+    l.offset = l.repeat ? wrap(l.offset, l.scaledW) : std::min(l.offset, static_cast<float>(l.maxOffset));
+}
+
+void Background::setOffsetFromCamera(float camX, float maxCam, float dt) {
+    for (Layer& l : layers) moveWithCamera(l, camX, maxCam, dt);
+}
+
+void Background::moveWithCamera(Layer& l, float camX, float maxCam, float dt) {
+    if (l.scaledW <= 0) return;
+
+    // max player speed calc
+    float maxStep = (l.maxSpeed > 0.0f) ? (l.maxSpeed * dt) : std::numeric_limits<float>::infinity();
+
+    // If no previous camera value, snap to the mapped position.
+    if (!l.prevCamValid) {
+        if (l.repeat) {
+            l.offset = wrap(camX * l.parallax, l.scaledW);
+        } else if (maxCam <= 0.0f || l.maxOffset == 0) {
+            l.offset = 0.0f;
+        } else {
+            // snap to full mapped range for non-repeating backgrounds
+            float ratio = std::max(0.0f, std::min(1.0f, camX / maxCam));
+            l.offset = ratio * static_cast<float>(l.maxOffset);
+        }
+        l.prevCamX = camX;
+        l.prevCamValid = true;
+        return;
+    }
+
+    // compute camera delta and apply proportional movement for consistent linear response
+    float delta = camX - l.prevCamX;
+    l.prevCamX = camX;
+    if (delta == 0.0f) return;
+
+    if (l.repeat) {
+        // repeating layers: move directly by camera delta scaled by parallax, then wrap
+        float move = std::max(-maxStep, std::min(maxStep, delta * l.parallax));
+        l.offset = wrap(l.offset + move, l.scaledW);
+    } else {
+        // non-repeating: map camera movement to background movement using maxOffset / maxCam
+        if (maxCam <= 0.0f || l.maxOffset == 0) {
+            l.offset = 0.0f;
+            return;
+        }
+        float move = delta * static_cast<float>(l.maxOffset) / maxCam; // full-range mapping
+        move = std::max(-maxStep, std::min(maxStep, move));
+        l.offset = std::max(0.0f, std::min(static_cast<float>(l.maxOffset), l.offset + move));
+    }
+}
+
+void Background::update(float dt) {
+    for (Layer& l : layers) {
+        // scrollSpeed == 0 leaves the layer purely camera-driven
+        if (l.scaledW <= 0 || l.scrollSpeed == 0.0f) continue;
+        l.offset += l.scrollSpeed * dt;
+        if (l.repeat) l.offset = wrap(l.offset, l.scaledW);
+        else l.offset = std::max(0.0f, std::min(static_cast<float>(l.maxOffset), l.offset));
+    }
+}
+
+void Background::render(SDL_Renderer* renderer) {
+    if (!renderer) return;
+    for (const Layer& l : layers) {
+        if (l.scaledW <= 0) continue;
+        int startX = -static_cast<int>(l.offset);
+        if (l.repeat) {
+            // offset is wrapped into [0, scaledW): only the copies that reach the frame
+            for (int x = startX; x < frameWidth; x += l.scaledW) {
+                SDL_Rect dst{ x, 0, l.scaledW, frameHeight };
+                SDL_RenderCopy(renderer, l.tex, nullptr, &dst);
+            }
+        } else {
+            SDL_Rect dst{ startX, 0, l.scaledW, frameHeight };
+            SDL_RenderCopy(renderer, l.tex, nullptr, &dst);
+        }
+    }
+}
@@ -0,0 +1,379 @@
+#include "ChunkedTileMap.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace {
+// Resident chunk memory allowed by default (1024 chunks = 64k columns of 16 rows)
+const size_t kDefaultBudget = 1024 * ChunkedTileMap::kChunkBytes;
+// Free chunk buffers kept around for reuse
+const size_t kMaxPooled = 64;
+}
+
+ChunkedTileMap::ChunkedTileMap()
+    : nRows(0)
+    , nCols(0)
+    , slotRows(0)
+    , slotCols(0)
+    , slotRowCap(0)
+    , useClock(0)
+    , pageInCount(0)
+    , evictCount(0)
+    , nextListenerId(1)
+    , budget(kDefaultBudget)
+    , pinMinChunkCol(0)
+    , pinMaxChunkCol(-1)
+{
+}
+
+ChunkedTileMap::ChunkedTileMap(int rows, int cols)
+    : ChunkedTileMap()
+{
+    assign(rows, cols);
+}
+
+ChunkedTileMap::~ChunkedTileMap() = default;
+
+void ChunkedTileMap::assign(int rows, int cols, Tile v) {
+    clear();
+    rows = std::max(0, rows);
+    cols = std::max(0, cols);
+    if (rows == 0 || cols == 0) return;
+    ensure(rows - 1, cols - 1);
+
+    if (v != TILE_EMPTY) {
+        // non-empty fill: write each chunk once and let the budget pack it away
+        for (int cc = 0; cc < slotCols; ++cc) {
+            for (int cr = 0; cr < slotRows; ++cr) {
+                TileGrid& g = pageIn(cr, cc);
+                int r1 = std::min(kChunkRows, nRows - cr * kChunkRows);
+                int c1 = std::min(kChunkCols, nCols - cc * kChunkCols);
+                for (int r = 0; r < r1; ++r) std::memset(g.row(r), v, static_cast<size_t>(c1));
+                slots[slotIndex(cr, cc)].dirty = true;
+            }
+        }
+    }
+    notify(-1, -1, TILE_EMPTY, v);
+}
+
+void ChunkedTileMap::assignRows(int rows, int cols, const std::function<void(int r, Tile* out)>& fillRow) {
+    clear();
+    rows = std::max(0, rows);
+    cols = std::max(0, cols);
+    if (rows == 0 || cols == 0 || !fillRow) {
+        notify(-1, -1, TILE_EMPTY, TILE_EMPTY);
+        return;
+    }
+    ensure(rows - 1, cols - 1);
+
+    std::vector<Tile> band(static_cast<size_t>(kChunkRows) * cols);
+    for (int cr = 0; cr < slotRows; ++cr) {
+        int bandRows = std::min(kChunkRows, nRows - cr * kChunkRows);
+        for (int r = 0; r < bandRows; ++r) fillRow(cr * kChunkRows + r, band.data() + static_cast<size_t>(r) * cols);
+
+        for (int cc = 0; cc < slotCols; ++cc) {
+            int c0 = cc * kChunkCols;
+            int n = std::min(kChunkCols, nCols - c0);
+            bool empty = true;
+            for (int r = 0; r < bandRows && empty; ++r) {
+                const Tile* src = band.data() + static_cast<size_t>(r) * cols + c0;
+                for (int c = 0; c < n; ++c) {
+                    if (src[c] != TILE_EMPTY) { empty = false; break; }
+                }
+            }
+            if (empty) continue; // untouched slot already reads as empty
+
+            TileGrid& g = pageIn(cr, cc);
+            for (int r = 0; r < bandRows; ++r) {
+                std::memcpy(g.row(r), band.data() + static_cast<size_t>(r) * cols + c0, static_cast<size_t>(n));
+            }
+            slots[slotIndex(cr, cc)].dirty = true;
+        }
+    }
+    notify(-1, -1, TILE_EMPTY, TILE_EMPTY);
+}
+
+void ChunkedTileMap::ensure(int r, int c) {
+    if (r < 0 || c < 0) return;
+    nRows = std::max(nRows, r + 1);
+    nCols = std::max(nCols, c + 1);
+    int needRows = (nRows + kChunkRows - 1) >> kChunkRowShift;
+    int needCols = (nCols + kChunkCols - 1) >> kChunkColShift;
+    if (needRows > slotRows || needCols > slotCols) growSlots(needRows, needCols);
+}
+
+void ChunkedTileMap::clear() {
+    for (size_t idx : resident) {
+        if (pool.size() < kMaxPooled) pool.push_back(std::move(slots[idx].data));
+    }
+    slots.clear();
+    resident.clear();
+    nRows = nCols = 0;
+    slotRows = slotCols = slotRowCap = 0;
+    pinMinChunkCol = 0;
+    pinMaxChunkCol = -1;
+    notify(-1, -1, TILE_EMPTY, TILE_EMPTY);
+}
+
+void ChunkedTileMap::set(int r, int c, Tile v) {
+    if (r < 0 || c < 0 || r >= nRows || c >= nCols) return;
+    int cr = r >> kChunkRowShift;
+    int cc = c >> kChunkColShift;
+    Slot& s = slots[slotIndex(cr, cc)];
+    if (!s.data) {
+        // writing empty into a never-touched chunk changes nothing
+        if (v == TILE_EMPTY && s.packed.empty()) return;
+        pageIn(cr, cc);
+    }
+    Tile& cell = s.data->row(r & (kChunkRows - 1))[c & (kChunkCols - 1)];
+    s.lastUse = ++useClock;
+    if (cell == v) return;
+    Tile old = cell;
+    cell = v;
+    s.dirty = true;
+    notify(r, c, old, v);
+}
+
+void ChunkedTileMap::copyRow(int r, int c0, int count, Tile* out) const {
+    if (!out || count <= 0) return;
+    if (r < 0 || r >= nRows) {
+        std::memset(out, TILE_EMPTY, static_cast<size_t>(count));
+        return;
+    }
+
+    TileGrid scratch;
+    int cr = r >> kChunkRowShift;
+    int rr = r & (kChunkRows - 1);
+    int c = c0;
+    int end = c0 + count;
+    while (c < end) {
+        if (c < 0 || c >= nCols) {
+            // outside the level: emit empty up to the next in-range column
+            int stop = (c < 0) ? std::min(end, 0) : end;
+            std::memset(out + (c - c0), TILE_EMPTY, static_cast<size_t>(stop - c));
+            c = stop;
+            continue;
+        }
+        int cc = c >> kChunkColShift;
+        int inChunk = c & (kChunkCols - 1);
+        int n = std::min(end, std::min(nCols, (cc + 1) * kChunkCols)) - c;
+        const Slot& s = slots[slotIndex(cr, cc)];
+        if (s.data) {
+            std::memcpy(out + (c - c0), s.data->row(rr) + inChunk, static_cast<size_t>(n));
+        } else if (s.packed.empty()) {
+            std::memset(out + (c - c0), TILE_EMPTY, static_cast<size_t>(n));
+        } else {
+            if (scratch.rows() == 0) scratch.assign(kChunkRows, kChunkCols);
+            unpackChunk(s.packed, scratch);
+            std::memcpy(out + (c - c0), scratch.row(rr) + inChunk, static_cast<size_t>(n));
+        }
+        c += n;
+    }
+}
+
+void ChunkedTileMap::snapshotTo(ChunkedTileMap& dst) const {
+    if (&dst == this) return;
+    dst.clear();
+    dst.nRows = nRows;
+    dst.nCols = nCols;
+    dst.slotRows = slotRows;
+    dst.slotCols = slotCols;
+    dst.slotRowCap = slotRowCap;
+    dst.slots.resize(slots.size());
+    for (size_t i = 0; i < slots.size(); ++i) {
+        const Slot& s = slots[i];
+        if (s.data && s.dirty) {
+            packChunk(*s.data, dst.slots[i].packed);
+        } else {
+            dst.slots[i].packed = s.packed; // still matches the resident copy
+        }
+    }
+    dst.notify(-1, -1, TILE_EMPTY, TILE_EMPTY);
+}
+
+void ChunkedTileMap::streamColumns(int colMin, int colMax) {
+    if (slotCols == 0) return;
+    if (colMin > colMax) std::swap(colMin, colMax);
+    pinMinChunkCol = std::max(0, colMin >> kChunkColShift);
+    pinMaxChunkCol = std::min(slotCols - 1, std::max(0, colMax) >> kChunkColShift);
+
+    for (int cc = pinMinChunkCol; cc <= pinMaxChunkCol; ++cc) {
+        for (int cr = 0; cr < slotRows; ++cr) {
+            Slot& s = slots[slotIndex(cr, cc)];
+            if (s.data) {
+                s.lastUse = ++useClock;
+            } else if (!s.packed.empty()) {
+                pageIn(cr, cc);
+            }
+        }
+    }
+    enforceBudget(std::numeric_limits<size_t>::max());
+}
+
+void ChunkedTileMap::setResidentBudget(size_t bytes) {
+    budget = std::max(bytes, kChunkBytes);
+    enforceBudget(std::numeric_limits<size_t>::max());
+}
+
+size_t ChunkedTileMap::residentBudget() const {
+    return budget;
+}
+
+int ChunkedTileMap::residentChunks() const {
+    return static_cast<int>(resident.size());
+}
+
+size_t ChunkedTileMap::residentBytes() const {
+    return resident.size() * kChunkBytes;
+}
+
+size_t ChunkedTileMap::packedBytes() const {
+    size_t total = 0;
+    for (const Slot& s : slots) total += s.packed.capacity();
+    return total;
+}
+
+int ChunkedTileMap::addChangeListener(ChangeListener listener) {
+    int id = nextListenerId++;
+    listeners.emplace_back(id, std::move(listener));
+    return id;
+}
+
+void ChunkedTileMap::removeChangeListener(int id) {
+    listeners.erase(std::remove_if(listeners.begin(), listeners.end(),
+                                   [id](const std::pair<int, ChangeListener>& l) { return l.first == id; }),
+                    listeners.end());
+}
+
+void ChunkedTileMap::notify(int r, int c, Tile oldValue, Tile newValue) {
+    for (auto& l : listeners) {
+        if (l.second) l.second(r, c, oldValue, newValue);
+    }
+}
+
+uint64_t ChunkedTileMap::pageIns() const {
+    return pageInCount;
+}
+
+uint64_t ChunkedTileMap::evictions() const {
+    return evictCount;
+}
+
+TileGrid& ChunkedTileMap::pageIn(int cr, int cc) const {
+    size_t idx = slotIndex(cr, cc);
+    Slot& s = slots[idx];
+    if (s.data) return *s.data;
+
+    if (!pool.empty()) {
+        s.data = std::move(pool.back());
+        pool.pop_back();
+    } else {
+        s.data.reset(new TileGrid(kChunkRows, kChunkCols));
+    }
+    if (s.packed.empty()) {
+        s.data->assign(kChunkRows, kChunkCols);
+    } else {
+        unpackChunk(s.packed, *s.data);
+    }
+    s.dirty = false;
+    s.lastUse = ++useClock;
+    resident.push_back(idx);
+    ++pageInCount;
+
+    enforceBudget(idx);
+    return *s.data;
+}
+
+void ChunkedTileMap::evictSlot(size_t idx) const {
+    Slot& s = slots[idx];
+    if (!s.data) return;
+    if (s.dirty) packChunk(*s.data, s.packed);
+    if (pool.size() < kMaxPooled) pool.push_back(std::move(s.data));
+    s.data.reset();
+    s.dirty = false;
+
+    auto it = std::find(resident.begin(), resident.end(), idx);
+    if (it != resident.end()) {
+        *it = resident.back();
+        resident.pop_back();
+    }
+    ++evictCount;
+}
+
+void ChunkedTileMap::enforceBudget(size_t keep) const {
+    while (resident.size() * kChunkBytes > budget) {
+        // least recently used chunk outside the pinned camera window
+        size_t victim = std::numeric_limits<size_t>::max();
+        uint64_t oldest = std::numeric_limits<uint64_t>::max();
+        for (size_t idx : resident) {
+            if (idx == keep) continue;
+            int cc = static_cast<int>(idx / static_cast<size_t>(slotRowCap));
+            if (cc >= pinMinChunkCol && cc <= pinMaxChunkCol) continue;
+            if (slots[idx].lastUse < oldest) {
+                oldest = slots[idx].lastUse;
+                victim = idx;
+            }
+        }
+        if (victim == std::numeric_limits<size_t>::max()) break;
+        evictSlot(victim);
+    }
+}
+
+void ChunkedTileMap::growSlots(int chunkRows, int chunkCols) {
+    if (chunkRows > slotRowCap) {
+        // re-layout with a larger per-column stride (rare: levels grow mostly sideways)
+        int newCap = std::max(chunkRows, slotRowCap * 2);
+        int cols = std::max(slotCols, chunkCols);
+        std::vector<Slot> next(static_cast<size_t>(cols) * newCap);
+        for (int cc = 0; cc < slotCols; ++cc) {
+            for (int cr = 0; cr < slotRows; ++cr) {
+                next[static_cast<size_t>(cc) * newCap + cr] = std::move(slots[slotIndex(cr, cc)]);
+            }
+        }
+        slots.swap(next);
+        slotRowCap = newCap;
+
+        resident.clear();
+        for (size_t i = 0; i < slots.size(); ++i) {
+            if (slots[i].data) resident.push_back(i);
+        }
+    } else if (chunkCols > slotCols) {
+        slots.resize(static_cast<size_t>(chunkCols) * slotRowCap);
+    }
+    slotRows = std::max(slotRows, chunkRows);
+    slotCols = std::max(slotCols, chunkCols);
+}
+
+void ChunkedTileMap::packChunk(const TileGrid& g, std::vector<uint8_t>& out) {
+    // runs of (tile, length lo, length hi); chunk cells are contiguous (stride == cols)
+    out.clear();
+    const Tile* cells = g.row(0);
+    size_t i = 0;
+    while (i < kChunkBytes) {
+        Tile v = cells[i];
+        size_t j = i + 1;
+        while (j < kChunkBytes && cells[j] == v) ++j;
+        size_t len = j - i;
+        out.push_back(v);
+        out.push_back(static_cast<uint8_t>(len & 0xFF));
+        out.push_back(static_cast<uint8_t>(len >> 8));
+        i = j;
+    }
+    // an all-empty chunk needs no storage
+    if (out.size() == 3 && out[0] == TILE_EMPTY) {
+        out.clear();
+        out.shrink_to_fit();
+    }
+}
+
+void ChunkedTileMap::unpackChunk(const std::vector<uint8_t>& in, TileGrid& g) {
+    Tile* cells = g.row(0);
+    size_t pos = 0;
+    for (size_t i = 0; i + 2 < in.size(); i += 3) {
+        size_t len = static_cast<size_t>(in[i + 1]) | (static_cast<size_t>(in[i + 2]) << 8);
+        len = std::min(len, kChunkBytes - pos);
+        std::memset(cells + pos, in[i], len);
+        pos += len;
+    }
+    if (pos < kChunkBytes) std::memset(cells + pos, TILE_EMPTY, kChunkBytes - pos);
+}
@@ -0,0 +1,221 @@
+#include "Collision.h"
+#include "Player.h"
+#include "Level.h"
+#include "TileOccupancy.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+void resolvePlayerCollisions(Player& player, Level& level, int cellW, int cellH) {
+    if (cellW <= 0 || cellH <= 0) return;
+    if (level.rows() <= 0 || level.cols() <= 0) return;
+
+    const float eps = 0.0001f;
+
+    // Physics: player.x is left, player.y is _feet_ (bottom).
+    float px = player.x;
+    float pw = static_cast<float>(player.width);
+    float top = player.y - static_cast<float>(player.height);
+    float ph = static_cast<float>(player.height);
+
+    int minCol = (int)std::floor(px / cellW);
+    int maxCol = (int)std::floor((px + pw - eps) / cellW);
+    int minRow = (int)std::floor(top / cellH);
+    int maxRow = (int)std::floor((top + ph - eps) / cellH);
+
+    minCol = std::max(0, minCol);
+    minRow = std::max(0, minRow);
+    maxCol = std::min(level.cols() - 1, maxCol);
+    maxRow = std::min(level.rows() - 1, maxRow);
+
+    // broadphase: only visit occupied cells, in the same row-major order as a full scan
+    static thread_local std::vector<TileOccupancy::Span> spans;
+    spans.clear();
+    level.occupancy.query(TileOccupancy::kAll, minRow, minCol, maxRow, maxCol, spans);
+
+    for (const TileOccupancy::Span& span : spans) {
+        const int r = span.row;
+        for (int c = span.c0; c <= span.c1; ++c) {
+            int cell = level.grid.get(r, c); // 1=solid,2=damaging,3=pickup
+            if (cell == 0) continue; // taken earlier in this pass
+
+            float tx = static_cast<float>(c * cellW);
+            float ty = static_cast<float>(r * cellH);
+
+            float ix = std::min(px + pw, tx + cellW) - std::max(px, tx);
+            float iy = std::min(top + ph, ty + cellH) - std::max(top, ty);
+
+            if (ix > 0.0f && iy > 0.0f) {
+                if (cell == 3) {
+                    player.score += 10;
+                    level.grid.set(r, c, TILE_EMPTY); // remove pickup
+                    continue;
+                }
+
+                bool isDamaging = (cell == 2);
+
+                // Resolve along smaller penetration (push player out)
+                if (ix < iy) {
+                    // horizontal push
+                    if (px + pw * 0.5f < tx + cellW * 0.5f) {
+                        // push left
+                        px -= ix;
+                    } else {
+                        // push right
+                        px += ix;
+                    }
+                    // apply immediate horizontal correction
+                    player.x = px;
+                } else {
+                    // vertical push
+                    if (top + ph * 0.5f < ty + cellH * 0.5f) {
+                        // collision from above -> place player on top of tile
+                        top = ty - ph;
+                        player.vy = 0.0f;
+                        player.onGround = true;
+                    } else {
+                        // collision from below -> push player down (head hit)
+                        top += iy;
+                        if (player.vy < 0.0f) player.vy = 0.0f;
+                    }
+                    // apply immediate vertical correction
+                    player.y = top + ph;
+                }
+
+                // Handle damage
+                if (isDamaging && player.invulnTimer <= 0.0f) {
+                    player.health -= 1;
+                    player.invulnTimer = player.invuln;
+                    if (player.health < 0) player.health = 0;
+                }
+            }
+        }
+    }
+
+    // Ensure the resolved values are applied
+    player.x = px;
+    player.y = top + ph;
+}
+
+namespace {
+const float kSweepEps = 0.0001f;
+
+int cellOf(float v, int size) {
+    return static_cast<int>(std::floor(v / size));
+}
+
+// OR of the classes in mask present in the given column/row strip
+uint8_t classesIn(const TileOccupancy& occ, uint8_t mask, int r0, int c0, int r1, int c1) {
+    uint8_t found = 0;
+    for (uint8_t bit : { TileOccupancy::kSolid, TileOccupancy::kDamaging, TileOccupancy::kPickup }) {
+        if ((mask & bit) && occ.any(bit, r0, c0, r1, c1)) found |= bit;
+    }
+    return found;
+}
+
+void collectPickups(Player& player, Level& level, float left, float top, float right, float bottom, int cellW, int cellH) {
+    static thread_local std::vector<TileOccupancy::Span> spans;
+    spans.clear();
+    level.occupancy.query(TileOccupancy::kPickup, cellOf(top, cellH), cellOf(left, cellW),
+                          cellOf(bottom - kSweepEps, cellH), cellOf(right - kSweepEps, cellW), spans);
+    for (const TileOccupancy::Span& s : spans) {
+        for (int c = s.c0; c <= s.c1; ++c) {
+            player.score += 10;
+            level.grid.set(s.row, c, TILE_EMPTY);
+        }
+    }
+}
+}
+
+SweepHit sweepBox(const TileOccupancy& occ, uint8_t mask, float& left, float& top, float w, float h,
+                  float dx, float dy, int cellW, int cellH) {
+    SweepHit hit;
+    if (cellW <= 0 || cellH <= 0) {
+        left += dx;
+        top += dy;
+        return hit;
+    }
+    static thread_local std::vector<TileOccupancy::Span> spans;
+
+    if (dx != 0.0f) {
+        int r0 = cellOf(top, cellH);
+        int r1 = cellOf(top + h - kSweepEps, cellH);
+        // columns entered by the leading edge, excluding ones already overlapped
+        int cFrom = dx > 0.0f ? cellOf(left + w - kSweepEps, cellW) + 1 : cellOf(left, cellW) - 1;
+        int cTo = dx > 0.0f ? cellOf(left + w + dx - kSweepEps, cellW) : cellOf(left + dx, cellW);
+        spans.clear();
+        bool blocked = (dx > 0.0f ? cFrom <= cTo : cTo <= cFrom) &&
+                       occ.query(mask, r0, std::min(cFrom, cTo), r1, std::max(cFrom, cTo), spans) > 0;
+        if (blocked) {
+            int col = dx > 0.0f ? spans.front().c0 : spans.front().c1;
+            for (const TileOccupancy::Span& s : spans) col = dx > 0.0f ? std::min(col, s.c0) : std::max(col, s.c1);
+            float stop = dx > 0.0f ? static_cast<float>(col * cellW) - w : static_cast<float>((col + 1) * cellW);
+            hit.hitX = true;
+            hit.toiX = std::max(0.0f, std::min(1.0f, (stop - left) / dx));
+            hit.classesX = classesIn(occ, mask, r0, col, r1, col);
+            left = stop;
+        } else {
+            left += dx;
+        }
+    }
+
+    if (dy != 0.0f) {
+        int c0 = cellOf(left, cellW);
+        int c1 = cellOf(left + w - kSweepEps, cellW);
+        int rFrom = dy > 0.0f ? cellOf(top + h - kSweepEps, cellH) + 1 : cellOf(top, cellH) - 1;
+        int rTo = dy > 0.0f ? cellOf(top + h + dy - kSweepEps, cellH) : cellOf(top + dy, cellH);
+        spans.clear();
+        bool blocked = (dy > 0.0f ? rFrom <= rTo : rTo <= rFrom) &&
+                       occ.query(mask, std::min(rFrom, rTo), c0, std::max(rFrom, rTo), c1, spans) > 0;
+        if (blocked) {
+            // spans come back in row order: first row is nearest going down, last going up
+            int row = dy > 0.0f ? spans.front().row : spans.back().row;
+            float stop = dy > 0.0f ? static_cast<float>(row * cellH) - h : static_cast<float>((row + 1) * cellH);
+            hit.hitY = true;
+            hit.toiY = std::max(0.0f, std::min(1.0f, (stop - top) / dy));
+            hit.classesY = classesIn(occ, mask, row, c0, row, c1);
+            top = stop;
+        } else {
+            top += dy;
+        }
+    }
+    return hit;
+}
+
+void movePlayerSwept(Player& player, Level& level, float fromX, float fromY, int cellW, int cellH) {
+    if (cellW <= 0 || cellH <= 0) return;
+    if (level.rows() <= 0 || level.cols() <= 0) return;
+
+    const float w = static_cast<float>(player.width);
+    const float h = static_cast<float>(player.height);
+    float dx = player.x - fromX;
+    float dy = player.y - fromY;
+
+    // player.y is the feet; sweep works on the top-left corner
+    float left = fromX;
+    float top = fromY - h;
+    float startTop = top;
+    SweepHit hit = sweepBox(level.occupancy, TileOccupancy::kBlocking, left, top, w, h, dx, dy, cellW, cellH);
+
+    if (hit.hitY) {
+        if (dy > 0.0f) {
+            player.vy = 0.0f;
+            player.onGround = true;
+        } else if (player.vy < 0.0f) {
+            player.vy = 0.0f; // head hit
+        }
+    }
+    player.x = left;
+    player.y = top + h;
+
+    // pickups along the actual path: the X leg, then the Y leg
+    collectPickups(player, level, std::min(fromX, left), startTop, std::max(fromX, left) + w, startTop + h, cellW, cellH);
+    collectPickups(player, level, left, std::min(startTop, top), left + w, std::max(startTop, top) + h, cellW, cellH);
+
+    uint8_t touched = static_cast<uint8_t>(hit.classesX | hit.classesY);
+    if ((touched & TileOccupancy::kDamaging) && player.invulnTimer <= 0.0f) {
+        player.health -= 1;
+        player.invulnTimer = player.invuln;
+        if (player.health < 0) player.health = 0;
+    }
+}
@@ -0,0 +1,75 @@
+#include "FixedTimestep.h"
+#include <algorithm>
+#include <cmath>
+
+FixedTimestep::FixedTimestep(double tickRate, int maxStepsPerFrame)
+    : rate(120.0)
+    , dt(1.0 / 120.0)
+    , maxSteps(8)
+    , accumulator(0.0)
+    , ticks(0)
+    , dropped(0)
+{
+    setTickRate(tickRate);
+    setMaxSteps(maxStepsPerFrame);
+}
+
+void FixedTimestep::setTickRate(double hz) {
+    if (hz <= 0.0) return;
+    rate = hz;
+    dt = 1.0 / hz;
+    // keep the carried fraction valid for the new step size
+    if (accumulator >= dt) accumulator = std::fmod(accumulator, dt);
+}
+
+void FixedTimestep::setMaxSteps(int steps) {
+    maxSteps = std::max(1, steps);
+}
+
+double FixedTimestep::tickRate() const {
+    return rate;
+}
+
+double FixedTimestep::tickDt() const {
+    return dt;
+}
+
+int FixedTimestep::advance(double frameDt) {
+    if (frameDt < 0.0) frameDt = 0.0;
+    accumulator += frameDt;
+
+    int steps = static_cast<int>(accumulator / dt);
+    if (steps > maxSteps) {
+        // spiral-of-death guard: simulate maxSteps and drop the rest
+        dropped += static_cast<uint64_t>(steps - maxSteps);
+        steps = maxSteps;
+        accumulator = std::fmod(accumulator, dt);
+    } else {
+        accumulator -= steps * dt;
+    }
+    if (accumulator < 0.0) accumulator = 0.0;
+
+    ticks += static_cast<uint64_t>(steps);
+    return steps;
+}
+
+float FixedTimestep::alpha() const {
+    float a = static_cast<float>(accumulator / dt);
+    if (a < 0.0f) a = 0.0f;
+    if (a > 1.0f) a = 1.0f;
+    return a;
+}
+
+uint64_t FixedTimestep::totalTicks() const {
+    return ticks;
+}
+
+uint64_t FixedTimestep::droppedTicks() const {
+    return dropped;
+}
+
+void FixedTimestep::reset() {
+    accumulator = 0.0;
+    ticks = 0;
+    dropped = 0;
+}
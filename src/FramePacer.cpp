@@ -0,0 +1,133 @@
+#include "FramePacer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+const double kMinSpinMs = 0.5;
+const double kMaxSpinMs = 4.0;
+}
+
+FramePacer::FramePacer(double targetFps, int historyFrames)
+    : fps(0.0)
+    , period(0)
+    , deadline(0)
+    , lastReturn(0)
+    , freq(static_cast<double>(SDL_GetPerformanceFrequency()) / 1000.0)
+    , spinMs(2.0)
+    , frameHist(static_cast<size_t>(std::max(1, historyFrames)), 0.0f)
+    , overshootHist(static_cast<size_t>(std::max(1, historyFrames)), 0.0f)
+    , head(0)
+    , count(0)
+{
+    setTargetFps(targetFps);
+}
+
+void FramePacer::setTargetFps(double target) {
+    fps = target > 0.0 ? target : 0.0;
+    period = fps > 0.0 ? static_cast<Uint64>(static_cast<double>(SDL_GetPerformanceFrequency()) / fps) : 0;
+    deadline = 0;
+}
+
+double FramePacer::targetFps() const {
+    return fps;
+}
+
+double FramePacer::wait() {
+    Uint64 start = SDL_GetPerformanceCounter();
+    if (period == 0) {
+        record(start, 0.0);
+        return 0.0;
+    }
+
+    if (deadline == 0) deadline = (lastReturn ? lastReturn : start) + period;
+    // more than a frame behind (hitch, breakpoint): start over from now
+    // rather than running a burst of unpaced frames
+    if (start > deadline + period) deadline = start + period;
+
+    Uint64 now = start;
+    while (now < deadline) {
+        double remainingMs = toMs(deadline - now);
+        if (remainingMs <= spinMs) break;
+        Uint32 sleepMs = static_cast<Uint32>(remainingMs - spinMs);
+        if (sleepMs == 0) break;
+        SDL_Delay(sleepMs);
+        Uint64 woke = SDL_GetPerformanceCounter();
+        // learn how late this OS wakes from sleeps: jump up to a late wake,
+        // drift back down slowly while wakes are punctual
+        double lateMs = toMs(woke - now) - sleepMs;
+        if (lateMs > spinMs) spinMs = std::min(kMaxSpinMs, lateMs * 1.25);
+        else spinMs = std::max(kMinSpinMs, spinMs * 0.995);
+        now = woke;
+    }
+    while (now < deadline) now = SDL_GetPerformanceCounter();
+
+    double overshoot = toMs(now - deadline);
+    deadline += period;
+    record(now, overshoot);
+    return toMs(now - start);
+}
+
+void FramePacer::resync() {
+    deadline = 0;
+    lastReturn = 0;
+}
+
+void FramePacer::record(Uint64 now, double overshootMs) {
+    if (lastReturn != 0) {
+        frameHist[head] = static_cast<float>(toMs(now - lastReturn));
+        overshootHist[head] = static_cast<float>(overshootMs);
+        head = (head + 1) % static_cast<int>(frameHist.size());
+        count = std::min(count + 1, static_cast<int>(frameHist.size()));
+    }
+    lastReturn = now;
+}
+
+double FramePacer::toMs(Uint64 ticks) const {
+    return static_cast<double>(ticks) / freq;
+}
+
+double FramePacer::lastFrameMs() const {
+    if (count == 0) return 0.0;
+    int n = static_cast<int>(frameHist.size());
+    return frameHist[(head + n - 1) % n];
+}
+
+double FramePacer::avgFrameMs() const {
+    if (count == 0) return 0.0;
+    double sum = 0.0;
+    for (int i = 0; i < count; ++i) sum += frameHist[i];
+    return sum / count;
+}
+
+double FramePacer::jitterMs() const {
+    if (count < 2) return 0.0;
+    double mean = avgFrameMs();
+    double sq = 0.0;
+    for (int i = 0; i < count; ++i) sq += (frameHist[i] - mean) * (frameHist[i] - mean);
+    return std::sqrt(sq / (count - 1));
+}
+
+double FramePacer::avgOvershootMs() const {
+    if (count == 0) return 0.0;
+    double sum = 0.0;
+    for (int i = 0; i < count; ++i) sum += overshootHist[i];
+    return sum / count;
+}
+
+double FramePacer::maxOvershootMs() const {
+    float m = 0.0f;
+    for (int i = 0; i < count; ++i) m = std::max(m, overshootHist[i]);
+    return m;
+}
+
+double FramePacer::spinMarginMs() const {
+    return spinMs;
+}
+
+void FramePacer::logStats(const char* label) const {
+    char target[32] = "uncapped";
+    if (fps > 0.0) std::snprintf(target, sizeof(target), "%.0f fps", fps);
+    SDL_Log("DBG: %s pacing: target %s, frame %.2f ms avg, jitter %.3f ms, overshoot %.3f avg / %.3f max ms, spin %.2f ms",
+            label, target, avgFrameMs(), jitterMs(), avgOvershootMs(), maxOvershootMs(), spinMs);
+}
@@ -0,0 +1,109 @@
+#include "FrameProfiler.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+const char* const kPhaseNames[PROF_PHASE_COUNT + 1] = {
+    "events", "player", "collide", "actors", "bg", "tiles", "sprites", "hud", "present", "sleep", "frame"
+};
+}
+
+FrameProfiler::FrameProfiler(int historyFrames)
+    : cap(std::max(1, historyFrames))
+    , head(0)
+    , filled(0)
+    , ring(static_cast<size_t>(cap) * kColumns, 0.0)
+    , frameStart(0)
+    , msPerTick(1000.0 / static_cast<double>(SDL_GetPerformanceFrequency()))
+    , overlay(false)
+{
+    std::fill(current, current + PROF_PHASE_COUNT, 0.0);
+}
+
+void FrameProfiler::beginFrame() {
+    std::fill(current, current + PROF_PHASE_COUNT, 0.0);
+    frameStart = SDL_GetPerformanceCounter();
+}
+
+void FrameProfiler::endFrame() {
+    if (frameStart == 0) return;
+    double* row = &ring[static_cast<size_t>(head) * kColumns];
+    std::copy(current, current + PROF_PHASE_COUNT, row);
+    row[PROF_PHASE_COUNT] = toMs(SDL_GetPerformanceCounter() - frameStart);
+    head = (head + 1) % cap;
+    filled = std::min(filled + 1, cap);
+    frameStart = 0;
+}
+
+void FrameProfiler::add(ProfPhase phase, double ms) {
+    if (phase >= 0 && phase < PROF_PHASE_COUNT) current[phase] += ms;
+}
+
+FrameProfiler::Stats FrameProfiler::stats(int phase) const {
+    Stats s;
+    if (filled == 0 || phase < 0 || phase > PROF_PHASE_COUNT) return s;
+    std::vector<double> v;
+    v.reserve(static_cast<size_t>(filled));
+    for (int i = 0; i < filled; ++i) v.push_back(ring[static_cast<size_t>(i) * kColumns + phase]);
+
+    double sum = 0.0;
+    for (double d : v) {
+        sum += d;
+        s.max = std::max(s.max, d);
+    }
+    s.avg = sum / filled;
+    size_t k = std::min(v.size() - 1, static_cast<size_t>(v.size() * 0.99));
+    std::nth_element(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(k), v.end());
+    s.p99 = v[k];
+    return s;
+}
+
+int FrameProfiler::frameCount() const {
+    return filled;
+}
+
+double FrameProfiler::frameMs(int ago) const {
+    if (ago < 0 || ago >= filled) return 0.0;
+    int row = (head - 1 - ago + cap) % cap;
+    return ring[static_cast<size_t>(row) * kColumns + PROF_PHASE_COUNT];
+}
+
+int FrameProfiler::capacity() const {
+    return cap;
+}
+
+bool FrameProfiler::dumpCsv(const std::string& path) const {
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Profiler: cannot write %s", path.c_str());
+        return false;
+    }
+    std::fprintf(f, "frame");
+    for (int p = 0; p < kColumns; ++p) std::fprintf(f, ",%s_ms", kPhaseNames[p]);
+    std::fprintf(f, "\n");
+
+    int first = (head - filled + cap) % cap;
+    for (int i = 0; i < filled; ++i) {
+        const double* row = &ring[static_cast<size_t>((first + i) % cap) * kColumns];
+        std::fprintf(f, "%d", i);
+        for (int p = 0; p < kColumns; ++p) std::fprintf(f, ",%.4f", row[p]);
+        std::fprintf(f, "\n");
+    }
+    bool ok = std::ferror(f) == 0;
+    std::fclose(f);
+    SDL_Log("DBG: profiler: %d frames written to %s", filled, path.c_str());
+    return ok;
+}
+
+const char* FrameProfiler::phaseName(int phase) {
+    if (phase < 0 || phase > PROF_PHASE_COUNT) return "?";
+    return kPhaseNames[phase];
+}
+
+void FrameProfiler::setOverlayVisible(bool v) {
+    overlay = v;
+}
+
+bool FrameProfiler::overlayVisible() const {
+    return overlay;
+}
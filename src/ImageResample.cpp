@@ -0,0 +1,169 @@
+#include "ImageResample.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+const float kSupport = 2.0f; // Mitchell kernel radius at scale 1
+
+float mitchell(float x) {
+    const float B = 1.0f / 3.0f;
+    const float C = 1.0f / 3.0f;
+    x = std::fabs(x);
+    if (x < 1.0f) return ((12 - 9 * B - 6 * C) * x * x * x + (-18 + 12 * B + 6 * C) * x * x + (6 - 2 * B)) / 6.0f;
+    if (x < 2.0f) return ((-B - 6 * C) * x * x * x + (6 * B + 30 * C) * x * x + (-12 * B - 48 * C) * x + (8 * B + 24 * C)) / 6.0f;
+    return 0.0f;
+}
+
+// sRGB <-> linear lookup tables, built once
+struct Gamma {
+    float toLinear[256];
+    uint8_t toSrgb[4096]; // indexed by linear * 4095
+
+    Gamma() {
+        for (int i = 0; i < 256; ++i) {
+            float c = i / 255.0f;
+            toLinear[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+        for (int i = 0; i < 4096; ++i) {
+            float l = i / 4095.0f;
+            float c = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+            toSrgb[i] = static_cast<uint8_t>(std::lround(std::min(1.0f, std::max(0.0f, c)) * 255.0f));
+        }
+    }
+};
+
+const Gamma& gamma() {
+    static const Gamma g;
+    return g;
+}
+
+// Per-output-sample source window and normalized weights
+struct Contributions {
+    std::vector<int> start;
+    std::vector<int> count;
+    std::vector<float> weights; // maxCount per sample
+    int maxCount = 0;
+};
+
+void buildContributions(int srcSize, int dstSize, Contributions& out) {
+    float scale = static_cast<float>(srcSize) / dstSize;
+    float widen = std::max(1.0f, scale); // shrinking: stretch the kernel over the source
+    float radius = kSupport * widen;
+    out.maxCount = static_cast<int>(std::ceil(radius * 2)) + 1;
+    out.start.assign(dstSize, 0);
+    out.count.assign(dstSize, 0);
+    out.weights.assign(static_cast<size_t>(dstSize) * out.maxCount, 0.0f);
+
+    for (int i = 0; i < dstSize; ++i) {
+        float center = (i + 0.5f) * scale - 0.5f;
+        int lo = std::max(0, static_cast<int>(std::floor(center - radius)) + 1);
+        int hi = std::min(srcSize - 1, static_cast<int>(std::floor(center + radius)));
+        hi = std::min(hi, lo + out.maxCount - 1);
+        float* w = &out.weights[static_cast<size_t>(i) * out.maxCount];
+        float sum = 0.0f;
+        for (int s = lo; s <= hi; ++s) {
+            w[s - lo] = mitchell((s - center) / widen);
+            sum += w[s - lo];
+        }
+        int n = hi - lo + 1;
+        if (n <= 0 || sum == 0.0f) {
+            // degenerate window: nearest sample
+            lo = std::min(srcSize - 1, std::max(0, static_cast<int>(std::lround(center))));
+            n = 1;
+            w[0] = 1.0f;
+            sum = 1.0f;
+        }
+        for (int k = 0; k < n; ++k) w[k] /= sum;
+        out.start[i] = lo;
+        out.count[i] = n;
+    }
+}
+}
+
+namespace ImageResample {
+bool resize(const uint8_t* src, int sw, int sh, int spitch,
+            uint8_t* dst, int dw, int dh, int dpitch) {
+    if (!src || !dst || sw <= 0 || sh <= 0 || dw <= 0 || dh <= 0) return false;
+    const Gamma& g = gamma();
+
+    Contributions cx, cy;
+    buildContributions(sw, dw, cx);
+    buildContributions(sh, dh, cy);
+
+    // Horizontally filtered source rows (linear, premultiplied), kept in a
+    // ring just big enough for one vertical window: rows are visited in order
+    const int ringSize = cy.maxCount + 1;
+    std::vector<float> ring(static_cast<size_t>(ringSize) * dw * 4);
+    std::vector<int> ringRow(ringSize, -1);
+    std::vector<float> lin(static_cast<size_t>(sw) * 4);
+
+    auto filterRow = [&](int r) -> const float* {
+        int slot = r % ringSize;
+        float* out = &ring[static_cast<size_t>(slot) * dw * 4];
+        if (ringRow[slot] == r) return out;
+        ringRow[slot] = r;
+
+        const uint8_t* row = src + static_cast<size_t>(r) * spitch;
+        for (int x = 0; x < sw; ++x) {
+            float a = row[x * 4 + 3] / 255.0f;
+            lin[x * 4 + 0] = g.toLinear[row[x * 4 + 0]] * a;
+            lin[x * 4 + 1] = g.toLinear[row[x * 4 + 1]] * a;
+            lin[x * 4 + 2] = g.toLinear[row[x * 4 + 2]] * a;
+            lin[x * 4 + 3] = a;
+        }
+        for (int x = 0; x < dw; ++x) {
+            const float* w = &cx.weights[static_cast<size_t>(x) * cx.maxCount];
+            const float* s = &lin[static_cast<size_t>(cx.start[x]) * 4];
+            float acc[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            for (int k = 0; k < cx.count[x]; ++k) {
+                acc[0] += s[k * 4 + 0] * w[k];
+                acc[1] += s[k * 4 + 1] * w[k];
+                acc[2] += s[k * 4 + 2] * w[k];
+                acc[3] += s[k * 4 + 3] * w[k];
+            }
+            out[x * 4 + 0] = acc[0];
+            out[x * 4 + 1] = acc[1];
+            out[x * 4 + 2] = acc[2];
+            out[x * 4 + 3] = acc[3];
+        }
+        return out;
+    };
+
+    std::vector<const float*> rows(cy.maxCount);
+    std::vector<float> acc(static_cast<size_t>(dw) * 4);
+    for (int y = 0; y < dh; ++y) {
+        const float* w = &cy.weights[static_cast<size_t>(y) * cy.maxCount];
+        int n = cy.count[y];
+        for (int k = 0; k < n; ++k) rows[k] = filterRow(cy.start[y] + k);
+
+        std::fill(acc.begin(), acc.end(), 0.0f);
+        for (int k = 0; k < n; ++k) {
+            const float* r = rows[k];
+            float wk = w[k];
+            for (int i = 0; i < dw * 4; ++i) acc[i] += r[i] * wk;
+        }
+
+        uint8_t* out = dst + static_cast<size_t>(y) * dpitch;
+        for (int x = 0; x < dw; ++x) {
+            // the filter's negative lobes can overshoot; clamp before converting back
+            float a = std::min(1.0f, std::max(0.0f, acc[x * 4 + 3]));
+            float inv = a > 0.0f ? 1.0f / a : 0.0f;
+            for (int c = 0; c < 3; ++c) {
+                float l = std::min(1.0f, std::max(0.0f, acc[x * 4 + c] * inv));
+                out[x * 4 + c] = g.toSrgb[static_cast<int>(l * 4095.0f + 0.5f)];
+            }
+            out[x * 4 + 3] = static_cast<uint8_t>(std::lround(a * 255.0f));
+        }
+    }
+    return true;
+}
+
+void fitHeight(int w, int h, int maxH, int& outW, int& outH) {
+    outW = w;
+    outH = h;
+    if (maxH <= 0 || h <= maxH || w <= 0 || h <= 0) return;
+    outH = maxH;
+    outW = std::max(1, static_cast<int>(std::lround(static_cast<double>(w) * maxH / h)));
+}
+}
@@ -0,0 +1,430 @@
+#include "InputRecording.h"
+#include "LevelFormat.h"
+#include <SDL.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace {
+void putU16(std::vector<uint8_t>& out, uint32_t v) {
+    out.push_back(static_cast<uint8_t>(v & 0xFF));
+    out.push_back(static_cast<uint8_t>((v >> 8) & 0xFF));
+}
+
+void putU32(std::vector<uint8_t>& out, uint32_t v) {
+    putU16(out, v & 0xFFFF);
+    putU16(out, v >> 16);
+}
+
+void putU64(std::vector<uint8_t>& out, uint64_t v) {
+    putU32(out, static_cast<uint32_t>(v & 0xFFFFFFFFu));
+    putU32(out, static_cast<uint32_t>(v >> 32));
+}
+
+void putF32(std::vector<uint8_t>& out, float f) {
+    uint32_t v;
+    std::memcpy(&v, &f, sizeof(v));
+    putU32(out, v);
+}
+
+void putF64(std::vector<uint8_t>& out, double d) {
+    uint64_t v;
+    std::memcpy(&v, &d, sizeof(v));
+    putU64(out, v);
+}
+
+void putVarint(std::vector<uint8_t>& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+// Bounds-checked little-endian reader; any overrun latches ok = false
+struct Reader {
+    const uint8_t* p;
+    const uint8_t* end;
+    bool ok = true;
+
+    bool need(size_t n) {
+        if (ok && static_cast<size_t>(end - p) < n) ok = false;
+        return ok;
+    }
+    uint32_t u16() {
+        if (!need(2)) return 0;
+        uint32_t v = static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8);
+        p += 2;
+        return v;
+    }
+    uint32_t u32() {
+        uint32_t lo = u16();
+        return lo | (u16() << 16);
+    }
+    uint64_t u64() {
+        uint64_t lo = u32();
+        return lo | (static_cast<uint64_t>(u32()) << 32);
+    }
+    float f32() {
+        uint32_t v = u32();
+        float f;
+        std::memcpy(&f, &v, sizeof(f));
+        return f;
+    }
+    double f64() {
+        uint64_t v = u64();
+        double d;
+        std::memcpy(&d, &v, sizeof(d));
+        return d;
+    }
+    uint64_t varint() {
+        uint64_t v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (!need(1)) return 0;
+            uint8_t b = *p++;
+            v |= static_cast<uint64_t>(b & 0x7F) << shift;
+            if (!(b & 0x80)) return v;
+        }
+        ok = false;
+        return 0;
+    }
+};
+
+bool fail(std::string* error, const std::string& msg) {
+    if (error) *error = msg;
+    return false;
+}
+}
+
+void InputRecording::PlayerStart::capture(const Player& p) {
+    x = p.x;
+    y = p.y;
+    vy = p.vy;
+    width = p.width;
+    height = p.height;
+    health = p.health;
+    score = p.score;
+    invuln = p.invuln;
+    invulnTimer = p.invulnTimer;
+    onGround = p.onGround;
+    facingLeft = p.facingLeft;
+}
+
+void InputRecording::PlayerStart::apply(Player& p) const {
+    p.x = x;
+    p.y = y;
+    p.vy = vy;
+    p.width = width;
+    p.height = height;
+    p.health = health;
+    p.score = score;
+    p.invuln = invuln;
+    p.invulnTimer = invulnTimer;
+    p.onGround = onGround;
+    p.facingLeft = facingLeft;
+    p.storePrevious();
+}
+
+uint8_t InputRecording::pack(const PlayerInput& in, bool paused) {
+    return static_cast<uint8_t>((in.left ? IN_LEFT : 0) | (in.right ? IN_RIGHT : 0) |
+                                (in.jump ? IN_JUMP : 0) | (paused ? IN_PAUSED : 0));
+}
+
+PlayerInput InputRecording::unpack(uint8_t bits) {
+    PlayerInput in;
+    in.left = (bits & IN_LEFT) != 0;
+    in.right = (bits & IN_RIGHT) != 0;
+    in.jump = (bits & IN_JUMP) != 0;
+    return in;
+}
+
+bool InputRecording::save(const std::string& path) const {
+    std::vector<uint8_t> out;
+    out.reserve(64 + level.size() + inputs.size() / 8 + edits.size() * 7 + checksums.size() * 8);
+    putU32(out, kMagic);
+    putU16(out, kVersion);
+    putU16(out, 0); // flags
+    putF64(out, tickDt);
+    putU32(out, static_cast<uint32_t>(cellSize));
+    putU32(out, checksumEvery);
+
+    putF32(out, player.x);
+    putF32(out, player.y);
+    putF32(out, player.vy);
+    putU32(out, static_cast<uint32_t>(player.width));
+    putU32(out, static_cast<uint32_t>(player.height));
+    putU32(out, static_cast<uint32_t>(player.health));
+    putU32(out, static_cast<uint32_t>(player.score));
+    putF32(out, player.invuln);
+    putF32(out, player.invulnTimer);
+    out.push_back(static_cast<uint8_t>((player.onGround ? 1 : 0) | (player.facingLeft ? 2 : 0)));
+
+    putU32(out, static_cast<uint32_t>(level.size()));
+    out.insert(out.end(), level.begin(), level.end());
+
+    // held keys repeat for many ticks, so inputs compress well as runs
+    putU64(out, inputs.size());
+    for (size_t i = 0; i < inputs.size();) {
+        size_t j = i + 1;
+        while (j < inputs.size() && inputs[j] == inputs[i]) ++j;
+        putVarint(out, j - i);
+        out.push_back(inputs[i]);
+        i = j;
+    }
+
+    putU32(out, static_cast<uint32_t>(edits.size()));
+    uint64_t lastTick = 0;
+    for (const Edit& e : edits) {
+        putVarint(out, e.tick - lastTick);
+        putVarint(out, static_cast<uint64_t>(e.row));
+        putVarint(out, static_cast<uint64_t>(e.col));
+        out.push_back(static_cast<uint8_t>(e.value));
+        lastTick = e.tick;
+    }
+
+    putU32(out, static_cast<uint32_t>(checksums.size()));
+    for (uint64_t c : checksums) putU64(out, c);
+
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream f(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!f.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()))) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Cannot write recording %s", tmpPath.c_str());
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Cannot replace %s: %s", path.c_str(), ec.message().c_str());
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool InputRecording::load(const std::string& path, std::string* error) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f) return fail(error, "cannot open " + path);
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+
+    Reader in{ data.data(), data.data() + data.size() };
+    if (in.u32() != kMagic || !in.ok) return fail(error, "not a recording");
+    uint32_t version = in.u16();
+    if (version != kVersion) return fail(error, "unsupported recording version " + std::to_string(version));
+    in.u16(); // flags
+
+    InputRecording r;
+    r.tickDt = in.f64();
+    r.cellSize = static_cast<int>(in.u32());
+    r.checksumEvery = in.u32();
+    if (in.ok && (!(r.tickDt > 0.0) || r.cellSize <= 0 || r.cellSize > LevelFormat::kMaxCellPixels)) return fail(error, "bad tick rate or cell size");
+
+    r.player.x = in.f32();
+    r.player.y = in.f32();
+    r.player.vy = in.f32();
+    r.player.width = static_cast<int>(in.u32());
+    r.player.height = static_cast<int>(in.u32());
+    r.player.health = static_cast<int>(in.u32());
+    r.player.score = static_cast<int>(in.u32());
+    r.player.invuln = in.f32();
+    r.player.invulnTimer = in.f32();
+    uint8_t pflags = in.need(1) ? *in.p++ : 0;
+    r.player.onGround = (pflags & 1) != 0;
+    r.player.facingLeft = (pflags & 2) != 0;
+
+    uint32_t levelSize = in.u32();
+    if (!in.need(levelSize)) return fail(error, "truncated level");
+    r.level.assign(in.p, in.p + levelSize);
+    in.p += levelSize;
+
+    uint64_t ticks = in.u64();
+    if (!in.ok) return fail(error, "truncated header");
+    if (ticks > kMaxTicks) return fail(error, "bad tick count");
+    while (in.ok && r.inputs.size() < ticks) {
+        uint64_t run = in.varint();
+        uint8_t bits = in.need(1) ? *in.p++ : 0;
+        if (run == 0 || run > ticks - r.inputs.size()) return fail(error, "bad input run");
+        r.inputs.insert(r.inputs.end(), static_cast<size_t>(run), bits);
+    }
+
+    uint32_t editCount = in.u32();
+    if (in.ok && editCount > static_cast<size_t>(in.end - in.p) / 4) return fail(error, "bad edit count");
+    uint64_t tick = 0;
+    for (uint32_t i = 0; i < editCount && in.ok; ++i) {
+        Edit e;
+        tick += in.varint();
+        e.tick = tick;
+        uint64_t row = in.varint();
+        uint64_t col = in.varint();
+        uint8_t value = in.need(1) ? *in.p++ : 0;
+        // replay grows the level to fit, so keep edits inside a loadable level
+        if (e.tick > ticks || row >= LevelFormat::kMaxRows || col >= LevelFormat::kMaxCols) return fail(error, "bad edit");
+        e.row = static_cast<int>(row);
+        e.col = static_cast<int>(col);
+        if (value >= TILE_TYPE_COUNT) return fail(error, "bad edit value");
+        e.value = static_cast<TileGrid::Tile>(value);
+        r.edits.push_back(e);
+    }
+
+    uint32_t checksumCount = in.u32();
+    if (in.ok && checksumCount > static_cast<size_t>(in.end - in.p) / 8) return fail(error, "bad checksum count");
+    for (uint32_t i = 0; i < checksumCount && in.ok; ++i) r.checksums.push_back(in.u64());
+
+    if (!in.ok) return fail(error, "truncated recording");
+    *this = std::move(r);
+    return true;
+}
+
+bool InputRecorder::begin(const Level& level, const Player& player, double tickDt, int cellSize, uint32_t checksumEvery) {
+    recording = false;
+    rec = InputRecording();
+    rec.tickDt = tickDt;
+    rec.cellSize = cellSize;
+    rec.checksumEvery = checksumEvery;
+    rec.player.capture(player);
+    std::string error;
+    if (!LevelFormat::write(level, rec.level, &error)) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Recording not started: %s", error.c_str());
+        return false;
+    }
+    recording = true;
+    return true;
+}
+
+bool InputRecorder::active() const {
+    return recording;
+}
+
+uint64_t InputRecorder::ticks() const {
+    return rec.inputs.size();
+}
+
+void InputRecorder::edit(int row, int col, TileGrid::Tile value) {
+    if (!recording) return;
+    InputRecording::Edit e;
+    e.tick = rec.inputs.size();
+    e.row = row;
+    e.col = col;
+    e.value = value;
+    rec.edits.push_back(e);
+}
+
+void InputRecorder::tick(const PlayerInput& in, bool paused, const Simulation& sim) {
+    if (!recording) return;
+    rec.inputs.push_back(InputRecording::pack(in, paused));
+    if (rec.checksumEvery > 0 && rec.inputs.size() % rec.checksumEvery == 0) rec.checksums.push_back(sim.checksum());
+}
+
+bool InputRecorder::finish(const std::string& path) {
+    if (!recording) return false;
+    recording = false;
+    bool ok = rec.save(path);
+    if (ok) {
+        SDL_Log("DBG: recorded %llu ticks (%zu edits) to %s",
+                static_cast<unsigned long long>(rec.inputs.size()), rec.edits.size(), path.c_str());
+    }
+    rec = InputRecording();
+    return ok;
+}
+
+void InputRecorder::cancel() {
+    recording = false;
+    rec = InputRecording();
+}
+
+Replayer::Replayer(const InputRecording& recording)
+    : rec(recording)
+    , pos(0)
+    , nextEdit(0)
+    , compared(0)
+    , bad(0)
+    , firstBad(0)
+    , valid(false)
+{
+    restart();
+}
+
+bool Replayer::restart() {
+    pos = 0;
+    nextEdit = 0;
+    compared = 0;
+    bad = 0;
+    firstBad = 0;
+    valid = LevelFormat::read(rec.level.data(), rec.level.size(), lvl, &err);
+    if (!valid) return false;
+    ply = Player();
+    rec.player.apply(ply);
+    sim = std::make_unique<Simulation>(lvl, ply, rec.cellSize);
+    return true;
+}
+
+bool Replayer::ok() const {
+    return valid;
+}
+
+const std::string& Replayer::error() const {
+    return err;
+}
+
+bool Replayer::step() {
+    if (!valid || done()) return false;
+    while (nextEdit < rec.edits.size() && rec.edits[nextEdit].tick <= pos) {
+        const InputRecording::Edit& e = rec.edits[nextEdit++];
+        lvl.ensureCell(e.row, e.col);
+        lvl.grid.set(e.row, e.col, e.value);
+    }
+    uint8_t bits = rec.inputs[static_cast<size_t>(pos)];
+    sim->setPaused((bits & InputRecording::IN_PAUSED) != 0);
+    sim->tick(InputRecording::unpack(bits), rec.tickDt);
+    ++pos;
+
+    if (rec.checksumEvery > 0 && pos % rec.checksumEvery == 0) {
+        size_t k = static_cast<size_t>(pos / rec.checksumEvery) - 1;
+        if (k < rec.checksums.size()) {
+            ++compared;
+            if (sim->checksum() != rec.checksums[k]) {
+                if (bad == 0) firstBad = pos;
+                ++bad;
+            }
+        }
+    }
+    return true;
+}
+
+uint64_t Replayer::tick() const {
+    return pos;
+}
+
+bool Replayer::done() const {
+    return pos >= rec.inputs.size();
+}
+
+uint64_t Replayer::checksum() const {
+    return sim ? sim->checksum() : 0;
+}
+
+int Replayer::checksumsCompared() const {
+    return compared;
+}
+
+int Replayer::mismatches() const {
+    return bad;
+}
+
+uint64_t Replayer::firstMismatchTick() const {
+    return firstBad;
+}
+
+Simulation& Replayer::simulation() {
+    return *sim;
+}
+
+Level& Replayer::level() {
+    return lvl;
+}
+
+Player& Replayer::player() {
+    return ply;
+}
@@ -1,13 +1,59 @@
 #include "LevelEditor.h"
+#include <SDL.h>
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <utility>
+
+namespace {
+
+void putVarint(std::vector<uint8_t>& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+// Only reads data this file wrote, so no bounds checks
+uint64_t getVarint(const uint8_t*& p) {
+    uint64_t v = 0;
+    int shift = 0;
+    while (*p & 0x80) {
+        v |= static_cast<uint64_t>(*p++ & 0x7F) << shift;
+        shift += 7;
+    }
+    v |= static_cast<uint64_t>(*p++) << shift;
+    return v;
+}
+
+} // namespace
+
+// Tiles are below 16, so a cell's old and new value share one byte
+uint8_t LevelEditor::packTile(const Change& ch) {
+    return static_cast<uint8_t>((ch.oldValue << 4) | (ch.newValue & 0x0F));
+}
+
+LevelEditor::Tile LevelEditor::unpackTile(uint8_t b, bool newValue) {
+    return static_cast<Tile>(newValue ? (b & 0x0F) : (b >> 4));
+}
 
 LevelEditor::LevelEditor(Level* l, int w, int h, float scale, int baseTile)
-    : level(l), windowW(w), windowH(h), tileScale(scale), baseTilePixels(baseTile) {}
+    : level(l), windowW(w), windowH(h), tileScale(scale), baseTilePixels(baseTile)
+    , inStroke(false), strokeValue(TILE_EMPTY), strokeRow(0), strokeCol(0)
+    , applied(0), historyUsed(0), historyCap(kDefaultHistoryBytes) {}
 
-void LevelEditor::handleMouse(float mx, float my, float camX_editor_f){
-    if (!level) return;
-    if (windowW <= 0 || windowH <= 0) return;
+void LevelEditor::setWindowSize(int w, int h) {
+    windowW = w;
+    windowH = h;
+}
+
+void LevelEditor::setCellSink(CellSink s) {
+    sink = std::move(s);
+}
+
+bool LevelEditor::cellAt(float mx, float my, float camX_editor_f, int* outRow, int* outCol) const {
+    if (windowW <= 0 || windowH <= 0) return false;
 
     float cellWf = std::max(1.0f, baseTilePixels * tileScale);
     float cellHf = cellWf;
@@ -18,10 +64,350 @@ void LevelEditor::handleMouse(float mx, float my, float camX_editor_f){
     int col = static_cast<int>(std::floor(worldX_editor_f / cellWf));
     int row = static_cast<int>(std::floor(worldY_editor_f / cellHf));
 
-    if (row < 0 || col < 0) return;
+    if (row < 0 || col < 0) return false;
+    if (outRow) *outRow = row;
+    if (outCol) *outCol = col;
+    return true;
+}
+
+bool LevelEditor::cycle(int row, int col) {
+    if (!level || row < 0 || col < 0) return false;
+    endStroke();
+    write(row, col, static_cast<Tile>((level->grid.get(row, col) + 1) % TILE_TYPE_COUNT));
+    return commit() > 0;
+}
+
+size_t LevelEditor::fillRect(int r0, int c0, int r1, int c1, Tile value) {
+    if (!level) return 0;
+    endStroke();
+    if (r0 > r1) std::swap(r0, r1);
+    if (c0 > c1) std::swap(c0, c1);
+    r0 = std::max(r0, 0);
+    c0 = std::max(c0, 0);
+    if (value == TILE_EMPTY) {
+        // nothing to clear outside the grid
+        r1 = std::min(r1, level->rows() - 1);
+        c1 = std::min(c1, level->cols() - 1);
+    } else if (r1 >= 0 && c1 >= 0) {
+        level->ensureCell(r1, c1); // grow once, not per cell
+    }
+    if (r1 < r0 || c1 < c0) return 0;
+
+    // row-major keeps pending changes sorted and touches one chunk band at a time
+    for (int r = r0; r <= r1; ++r)
+        for (int c = c0; c <= c1; ++c) write(r, c, value);
+    return commit();
+}
+
+size_t LevelEditor::floodFill(int row, int col, Tile value, size_t maxCells) {
+    if (!level) return 0;
+    endStroke();
+    const int rows = level->rows();
+    const int cols = level->cols();
+    if (row < 0 || col < 0 || row >= rows || col >= cols) return 0;
+
+    const ChunkedTileMap& grid = level->grid;
+    const Tile src = grid.get(row, col);
+    if (src == value) return 0;
+
+    // scanline fill: filled cells no longer match src, so nothing is revisited
+    std::vector<std::pair<int, int>> seeds;
+    seeds.emplace_back(row, col);
+    while (!seeds.empty()) {
+        int r = seeds.back().first;
+        int c = seeds.back().second;
+        seeds.pop_back();
+        if (grid.get(r, c) != src) continue;
+
+        int left = c;
+        while (left > 0 && grid.get(r, left - 1) == src) --left;
+        int right = c;
+        while (right + 1 < cols && grid.get(r, right + 1) == src) ++right;
+
+        if (pending.size() + static_cast<size_t>(right - left + 1) > maxCells) {
+            revertPending();
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Flood fill stopped: area is over %zu cells", maxCells);
+            return 0;
+        }
+        for (int k = left; k <= right; ++k) write(r, k, value);
+
+        for (int nr = r - 1; nr <= r + 1; nr += 2) {
+            if (nr < 0 || nr >= rows) continue;
+            bool inRun = false;
+            for (int k = left; k <= right; ++k) {
+                bool match = grid.get(nr, k) == src;
+                if (match && !inRun) seeds.emplace_back(nr, k);
+                inRun = match;
+            }
+        }
+    }
+    return commit();
+}
+
+void LevelEditor::beginStroke(int row, int col, Tile value) {
+    if (!level) return;
+    endStroke();
+    inStroke = true;
+    strokeValue = value;
+    strokeRow = row;
+    strokeCol = col;
+    write(row, col, value);
+}
+
+void LevelEditor::strokeTo(int row, int col) {
+    if (!inStroke) return;
+    // Bresenham, so fast drags leave no gaps
+    int r = strokeRow;
+    int c = strokeCol;
+    int dr = std::abs(row - r);
+    int dc = std::abs(col - c);
+    int sr = r < row ? 1 : -1;
+    int sc = c < col ? 1 : -1;
+    int err = dc - dr;
+    for (;;) {
+        write(r, c, strokeValue);
+        if (r == row && c == col) break;
+        int e2 = 2 * err;
+        if (e2 > -dr) { err -= dr; c += sc; }
+        if (e2 < dc) { err += dc; r += sr; }
+    }
+    strokeRow = row;
+    strokeCol = col;
+}
+
+size_t LevelEditor::endStroke() {
+    if (!inStroke) return 0;
+    inStroke = false;
+    return commit();
+}
+
+bool LevelEditor::stroking() const {
+    return inStroke;
+}
+
+bool LevelEditor::copy(int r0, int c0, int r1, int c1) {
+    if (!level) return false;
+    if (r0 > r1) std::swap(r0, r1);
+    if (c0 > c1) std::swap(c0, c1);
+    r0 = std::max(r0, 0);
+    c0 = std::max(c0, 0);
+    if (r1 < r0 || c1 < c0) return false;
+
+    clip.rows = r1 - r0 + 1;
+    clip.cols = c1 - c0 + 1;
+    clip.tiles.assign(static_cast<size_t>(clip.rows) * clip.cols, TILE_EMPTY);
+    // copyRow reads packed chunks in place instead of paging them in
+    for (int i = 0; i < clip.rows; ++i)
+        level->grid.copyRow(r0 + i, c0, clip.cols, clip.tiles.data() + static_cast<size_t>(i) * clip.cols);
+    return true;
+}
+
+size_t LevelEditor::paste(int row, int col) {
+    if (!level || clip.empty() || row < 0 || col < 0) return 0;
+    endStroke();
+    const Tile* src = clip.tiles.data();
+    for (int i = 0; i < clip.rows; ++i)
+        for (int j = 0; j < clip.cols; ++j) write(row + i, col + j, *src++);
+    return commit();
+}
+
+const LevelEditor::Region& LevelEditor::clipboard() const {
+    return clip;
+}
+
+bool LevelEditor::undo() {
+    endStroke();
+    if (applied == 0) return false;
+    applyEntry(history[--applied], false);
+    return true;
+}
+
+bool LevelEditor::redo() {
+    endStroke();
+    if (applied == history.size()) return false;
+    applyEntry(history[applied++], true);
+    return true;
+}
+
+bool LevelEditor::canUndo() const {
+    return applied > 0 || !pending.empty();
+}
+
+bool LevelEditor::canRedo() const {
+    return applied < history.size();
+}
+
+void LevelEditor::clearHistory() {
+    inStroke = false;
+    pending.clear();
+    history.clear();
+    applied = 0;
+    historyUsed = 0;
+}
+
+void LevelEditor::setHistoryLimit(size_t bytes) {
+    historyCap = bytes;
+    enforceLimit();
+}
+
+size_t LevelEditor::historyLimit() const {
+    return historyCap;
+}
+
+size_t LevelEditor::historyBytes() const {
+    return historyUsed;
+}
+
+size_t LevelEditor::undoSteps() const {
+    return applied;
+}
+
+size_t LevelEditor::redoSteps() const {
+    return history.size() - applied;
+}
+
+void LevelEditor::write(int r, int c, Tile v) {
+    if (r < 0 || c < 0) return;
+    // reads outside the grid are empty, so clearing there never grows it
+    Tile old = level->grid.get(r, c);
+    if (old == v) return;
+    level->ensureCell(r, c);
+    level->grid.set(r, c, v);
+    pending.push_back({r, c, old, v});
+    if (sink) sink(r, c, v);
+}
+
+void LevelEditor::apply(int r, int c, Tile v) {
+    if (level->grid.get(r, c) == v) return;
+    level->ensureCell(r, c);
+    level->grid.set(r, c, v);
+    if (sink) sink(r, c, v);
+}
+
+void LevelEditor::applyEntry(const Entry& e, bool redoing) {
+    if (!level) return;
+    const uint8_t* p = e.data.data();
+    const uint8_t* end = p + e.data.size();
+    int row = 0;
+    int spanEnd = 0;
+    while (p < end) {
+        int rowDelta = static_cast<int>(getVarint(p));
+        if (rowDelta != 0) {
+            row += rowDelta;
+            spanEnd = 0;
+        }
+        int c = spanEnd + static_cast<int>(getVarint(p));
+        uint64_t left = getVarint(p);
+        while (left > 0) {
+            uint64_t header = getVarint(p);
+            uint64_t count = header >> 1;
+            if (header & 1) {
+                for (uint64_t k = 0; k < count; ++k) apply(row, c++, unpackTile(*p++, redoing));
+            } else {
+                Tile v = unpackTile(*p++, redoing);
+                for (uint64_t k = 0; k < count; ++k) apply(row, c++, v);
+            }
+            left -= count;
+        }
+        spanEnd = c;
+    }
+}
+
+size_t LevelEditor::commit() {
+    if (pending.empty()) return 0;
+
+    // line strokes and flood fills write out of order; rect fills and pastes don't
+    auto byCell = [](const Change& a, const Change& b) {
+        return a.r != b.r ? a.r < b.r : a.c < b.c;
+    };
+    if (!std::is_sorted(pending.begin(), pending.end(), byCell))
+        std::stable_sort(pending.begin(), pending.end(), byCell);
+
+    // a cell written twice keeps its first old and last new value
+    size_t n = 0;
+    for (size_t i = 0; i < pending.size(); ++i) {
+        if (n > 0 && pending[n - 1].r == pending[i].r && pending[n - 1].c == pending[i].c) {
+            pending[n - 1].newValue = pending[i].newValue;
+        } else {
+            pending[n++] = pending[i];
+        }
+    }
+    pending.resize(n);
+    pending.erase(std::remove_if(pending.begin(), pending.end(),
+                                 [](const Change& ch) { return ch.oldValue == ch.newValue; }),
+                  pending.end());
+    if (pending.empty()) return 0;
+
+    Entry entry;
+    entry.cells = pending.size();
+    int prevRow = 0;
+    int prevEnd = 0;
+    for (size_t i = 0; i < pending.size();) {
+        size_t j = i + 1;
+        while (j < pending.size() && pending[j].r == pending[i].r && pending[j].c == pending[j - 1].c + 1) ++j;
+
+        if (pending[i].r != prevRow) prevEnd = 0;
+        putVarint(entry.data, static_cast<uint64_t>(pending[i].r - prevRow));
+        putVarint(entry.data, static_cast<uint64_t>(pending[i].c - prevEnd));
+        putVarint(entry.data, j - i);
+        auto same = [&](size_t a, size_t b) {
+            return pending[a].oldValue == pending[b].oldValue && pending[a].newValue == pending[b].newValue;
+        };
+        for (size_t k = i; k < j;) {
+            size_t m = k + 1;
+            while (m < j && same(m, k)) ++m;
+            if (m - k < kMinRun) {
+                // literal up to where the next long run starts
+                m = k + 1;
+                while (m < j && !(m + kMinRun <= j && same(m + 1, m) && same(m + kMinRun - 1, m))) ++m;
+                putVarint(entry.data, ((m - k) << 1) | 1);
+                for (size_t x = k; x < m; ++x) entry.data.push_back(packTile(pending[x]));
+            } else {
+                putVarint(entry.data, (m - k) << 1);
+                entry.data.push_back(packTile(pending[k]));
+            }
+            k = m;
+        }
+
+        prevRow = pending[i].r;
+        prevEnd = pending[j - 1].c + 1;
+        i = j;
+    }
+    entry.data.shrink_to_fit();
+    pending.clear();
+
+    // a new edit forgets what could be redone
+    while (history.size() > applied) {
+        historyUsed -= history.back().bytes();
+        history.pop_back();
+    }
+    historyUsed += entry.bytes();
+    history.push_back(std::move(entry));
+    applied = history.size();
+    enforceLimit();
+    return history.back().cells;
+}
+
+void LevelEditor::revertPending() {
+    for (size_t i = pending.size(); i-- > 0;) {
+        const Change& ch = pending[i];
+        level->grid.set(ch.r, ch.c, ch.oldValue);
+        if (sink) sink(ch.r, ch.c, ch.oldValue);
+    }
+    pending.clear();
+}
 
-    // Ensure the grid is large enough and cycle the cell
-    // 0 -> 1 -> 2 -> 3 -> 0 (empty -> solid -> damaging -> pickup -> empty)
-    level->ensureCell(row, col);
-    level->grid[row][col] = (level->grid[row][col] + 1) % 4;
-}
\ No newline at end of file
+void LevelEditor::enforceLimit() {
+    // Oldest undo steps go first, then the furthest redo steps. The newest
+    // entry stays even when it alone is over the limit.
+    while (historyUsed > historyCap && history.size() > 1) {
+        if (applied > 0) {
+            historyUsed -= history.front().bytes();
+            history.pop_front();
+            --applied;
+        } else {
+            historyUsed -= history.back().bytes();
+            history.pop_back();
+        }
+    }
+}
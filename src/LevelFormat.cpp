@@ -0,0 +1,372 @@
+#include "LevelFormat.h"
+#include "Level.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+void putU16(std::vector<uint8_t>& out, uint32_t v) {
+    out.push_back(static_cast<uint8_t>(v & 0xFF));
+    out.push_back(static_cast<uint8_t>((v >> 8) & 0xFF));
+}
+
+void putU32(std::vector<uint8_t>& out, uint32_t v) {
+    putU16(out, v & 0xFFFF);
+    putU16(out, v >> 16);
+}
+
+void putVarint(std::vector<uint8_t>& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+void putString(std::vector<uint8_t>& out, const std::string& s) {
+    size_t n = std::min<size_t>(s.size(), 0xFFFF);
+    putU16(out, static_cast<uint32_t>(n));
+    out.insert(out.end(), s.begin(), s.begin() + static_cast<std::ptrdiff_t>(n));
+}
+
+// Bounds-checked little-endian reader; any overrun latches ok = false
+struct Reader {
+    const uint8_t* p;
+    const uint8_t* end;
+    bool ok = true;
+
+    bool need(size_t n) {
+        if (ok && static_cast<size_t>(end - p) < n) ok = false;
+        return ok;
+    }
+    uint32_t u16() {
+        if (!need(2)) return 0;
+        uint32_t v = static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8);
+        p += 2;
+        return v;
+    }
+    uint32_t u32() {
+        uint32_t lo = u16();
+        return lo | (u16() << 16);
+    }
+    uint64_t varint() {
+        uint64_t v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (!need(1)) return 0;
+            uint8_t b = *p++;
+            v |= static_cast<uint64_t>(b & 0x7F) << shift;
+            if (!(b & 0x80)) return v;
+        }
+        ok = false;
+        return 0;
+    }
+    std::string str() {
+        size_t n = u16();
+        if (!need(n)) return std::string();
+        std::string s(reinterpret_cast<const char*>(p), n);
+        p += n;
+        return s;
+    }
+};
+
+const char* expectedMessage(char ch) {
+    switch (ch) {
+    case '{': return "expected '{'";
+    case '}': return "expected '}' or ','";
+    case '[': return "expected '['";
+    case ']': return "expected ']' or ','";
+    case ':': return "expected ':'";
+    case '"': return "expected a string";
+    default: return "unexpected character";
+    }
+}
+
+// Cursor over the text dump; errors latch the first position and message
+struct TextParser {
+    const char* begin;
+    const char* p;
+    const char* end;
+    const char* errAt = nullptr;
+    const char* errMsg = nullptr;
+
+    bool fail(const char* msg) {
+        if (!errAt) {
+            errAt = p;
+            errMsg = msg;
+        }
+        return false;
+    }
+    void skipWs() {
+        while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) ++p;
+    }
+    bool expect(char ch) {
+        skipWs();
+        if (p >= end || *p != ch) return fail(expectedMessage(ch));
+        ++p;
+        return true;
+    }
+    // true and consumes ch if it is next
+    bool accept(char ch) {
+        skipWs();
+        if (p < end && *p == ch) {
+            ++p;
+            return true;
+        }
+        return false;
+    }
+    bool string(const char*& s, size_t& n) {
+        if (!expect('"')) return false;
+        s = p;
+        while (p < end && *p != '"' && *p != '\n') ++p;
+        if (p >= end || *p != '"') return fail("unterminated string");
+        n = static_cast<size_t>(p - s);
+        ++p;
+        return true;
+    }
+    bool number(uint64_t& v, uint64_t max) {
+        skipWs();
+        if (p >= end || *p < '0' || *p > '9') return fail("expected a number");
+        v = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            v = v * 10 + static_cast<uint64_t>(*p - '0');
+            if (v > max) return fail("number out of range");
+            ++p;
+        }
+        return true;
+    }
+    // 1-based line/column of the error, computed only when reporting
+    std::string where() const {
+        int line = 1, col = 1;
+        for (const char* q = begin; q < errAt; ++q) {
+            if (*q == '\n') {
+                ++line;
+                col = 1;
+            } else {
+                ++col;
+            }
+        }
+        return std::to_string(line) + ":" + std::to_string(col) + ": " + errMsg;
+    }
+};
+
+bool keyIs(const char* s, size_t n, const char* key) {
+    return std::strlen(key) == n && std::memcmp(s, key, n) == 0;
+}
+}
+
+namespace LevelFormat {
+
+// Checked before anything is allocated
+bool dimensionsOk(uint64_t rows, uint64_t cols) {
+    return rows <= kMaxRows && cols <= kMaxCols && rows * cols <= kMaxCells;
+}
+
+bool write(const Level& level, std::vector<uint8_t>& out, std::string* error) {
+    const int rows = level.rows();
+    const int cols = level.cols();
+    out.clear();
+    if (!dimensionsOk(static_cast<uint64_t>(rows), static_cast<uint64_t>(cols))) {
+        if (error) *error = "level too large (" + std::to_string(rows) + " x " + std::to_string(cols) + ")";
+        return false;
+    }
+    putU32(out, kMagic);
+    putU16(out, kVersion);
+    putU16(out, 0);
+    putU32(out, static_cast<uint32_t>(rows));
+    putU32(out, static_cast<uint32_t>(cols));
+    putString(out, level.backgroundPath);
+    putU32(out, static_cast<uint32_t>(level.usedAssets.size()));
+    for (const std::string& a : level.usedAssets) putString(out, a);
+
+    // runs continue across row ends; rows are pulled without paging chunks in
+    std::vector<uint8_t> row(static_cast<size_t>(std::max(0, cols)));
+    uint64_t runLen = 0;
+    uint8_t runTile = TILE_EMPTY;
+    for (int r = 0; r < rows; ++r) {
+        level.grid.copyRow(r, 0, cols, row.data());
+        for (int c = 0; c < cols; ++c) {
+            if (row[c] == runTile) {
+                ++runLen;
+                continue;
+            }
+            if (runLen) {
+                putVarint(out, runLen);
+                out.push_back(runTile);
+            }
+            runTile = row[c];
+            runLen = 1;
+        }
+    }
+    if (runLen) {
+        putVarint(out, runLen);
+        out.push_back(runTile);
+    }
+    return true;
+}
+
+bool read(const uint8_t* data, size_t size, Level& level, std::string* error) {
+    auto fail = [error](const char* msg) {
+        if (error) *error = msg;
+        return false;
+    };
+    if (!data) return fail("no data");
+
+    Reader in{ data, data + size };
+    if (in.u32() != kMagic) return fail("not a level file (bad magic)");
+    uint32_t version = in.u16();
+    in.u16(); // flags, none defined yet
+    if (in.ok && version > kVersion) return fail("level file is from a newer version");
+    uint32_t rows = in.u32();
+    uint32_t cols = in.u32();
+    if (!dimensionsOk(rows, cols)) {
+        return fail("level dimensions out of range");
+    }
+    std::string background = in.str();
+    uint32_t assetCount = in.u32();
+    std::vector<std::string> assets;
+    for (uint32_t i = 0; i < assetCount && in.ok; ++i) assets.push_back(in.str());
+    if (!in.ok) return fail("truncated header");
+
+    // validate the tile stream before touching the level
+    const uint8_t* tiles = in.p;
+    uint64_t total = static_cast<uint64_t>(rows) * cols;
+    uint64_t covered = 0;
+    while (covered < total && in.ok) {
+        uint64_t len = in.varint();
+        if (!in.need(1)) break;
+        uint8_t t = *in.p++;
+        if (len == 0 || len > total - covered) return fail("corrupt tile run");
+        if (t >= TILE_TYPE_COUNT) return fail("unknown tile type");
+        covered += len;
+    }
+    if (!in.ok || covered != total) return fail("truncated tile data");
+
+    Reader runs{ tiles, in.p };
+    uint64_t left = 0;
+    uint8_t tile = TILE_EMPTY;
+    level.grid.assignRows(static_cast<int>(rows), static_cast<int>(cols), [&](int, ChunkedTileMap::Tile* out) {
+        uint32_t c = 0;
+        while (c < cols) {
+            if (left == 0) {
+                left = runs.varint();
+                tile = *runs.p++;
+            }
+            uint32_t n = static_cast<uint32_t>(std::min<uint64_t>(left, cols - c));
+            std::memset(out + c, tile, n);
+            c += n;
+            left -= n;
+        }
+    });
+    level.backgroundPath = std::move(background);
+    level.usedAssets = std::move(assets);
+    return true;
+}
+
+bool readText(const char* data, size_t size, Level& level, std::string* error) {
+    if (!data) {
+        if (error) *error = "no data";
+        return false;
+    }
+    TextParser in{ data, data, data + size };
+    uint64_t rows = 0, cols = 0;
+    bool haveRows = false, haveCols = false, haveGrid = false;
+    std::string background;
+    std::vector<std::string> assets;
+    std::vector<uint8_t> cells;
+
+    bool ok = in.expect('{');
+    while (ok && !in.accept('}')) {
+        const char* key = nullptr;
+        size_t keyLen = 0;
+        ok = in.string(key, keyLen) && in.expect(':');
+        if (!ok) break;
+
+        if (keyIs(key, keyLen, "rows")) {
+            ok = in.number(rows, 0x7FFFFFFF);
+            haveRows = true;
+        } else if (keyIs(key, keyLen, "cols")) {
+            ok = in.number(cols, 0x7FFFFFFF);
+            haveCols = true;
+        } else if (keyIs(key, keyLen, "backgroundPath")) {
+            const char* s = nullptr;
+            size_t n = 0;
+            ok = in.string(s, n);
+            if (ok) background.assign(s, n);
+        } else if (keyIs(key, keyLen, "usedAssets")) {
+            ok = in.expect('[');
+            if (ok && !in.accept(']')) {
+                do {
+                    const char* s = nullptr;
+                    size_t n = 0;
+                    ok = in.string(s, n);
+                    if (ok) assets.emplace_back(s, n);
+                } while (ok && in.accept(','));
+                ok = ok && in.expect(']');
+            }
+        } else if (keyIs(key, keyLen, "grid")) {
+            if (!haveRows || !haveCols) {
+                ok = in.fail("\"grid\" must come after \"rows\" and \"cols\"");
+                break;
+            }
+            if (!dimensionsOk(rows, cols)) {
+                ok = in.fail("level dimensions out of range");
+                break;
+            }
+            // grown row by row as cells are parsed; every cell takes at least
+            // two bytes of text, so a header alone can't force a big allocation
+            cells.clear();
+            cells.reserve(static_cast<size_t>(std::min<uint64_t>(rows * cols, size / 2 + 1)));
+            ok = in.expect('[');
+            uint64_t r = 0;
+            if (ok && !in.accept(']')) {
+                do {
+                    if (r >= rows) {
+                        ok = in.fail("more grid rows than \"rows\"");
+                        break;
+                    }
+                    ok = in.expect('[');
+                    cells.resize(cells.size() + static_cast<size_t>(cols), TILE_EMPTY);
+                    uint8_t* out = cells.data() + r * cols;
+                    uint64_t c = 0;
+                    if (ok && !in.accept(']')) {
+                        do {
+                            uint64_t v = 0;
+                            if (c >= cols) {
+                                ok = in.fail("more cells than \"cols\"");
+                                break;
+                            }
+                            ok = in.number(v, TILE_TYPE_COUNT - 1);
+                            if (ok) out[c++] = static_cast<uint8_t>(v);
+                        } while (ok && in.accept(','));
+                        ok = ok && in.expect(']');
+                    }
+                    if (ok && c != cols) ok = in.fail("row has fewer cells than \"cols\"");
+                    ++r;
+                } while (ok && in.accept(','));
+                ok = ok && in.expect(']');
+            }
+            if (ok && r != rows) ok = in.fail("fewer grid rows than \"rows\"");
+            haveGrid = ok;
+        } else {
+            ok = in.fail("unknown key");
+        }
+        if (ok && !in.accept(',')) {
+            ok = in.expect('}');
+            break;
+        }
+    }
+    if (ok && !haveGrid) ok = in.fail("missing \"grid\"");
+
+    if (!ok) {
+        if (error) *error = in.where();
+        return false;
+    }
+
+    level.grid.assignRows(static_cast<int>(rows), static_cast<int>(cols), [&](int r, ChunkedTileMap::Tile* out) {
+        std::memcpy(out, cells.data() + static_cast<size_t>(r) * cols, static_cast<size_t>(cols));
+    });
+    level.backgroundPath = std::move(background);
+    level.usedAssets = std::move(assets);
+    return true;
+}
+
+}
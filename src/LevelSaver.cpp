@@ -0,0 +1,83 @@
+#include "LevelSaver.h"
+#include <chrono>
+
+LevelSaver::LevelSaver()
+    : writing(false)
+    , stopping(false)
+{
+    worker = std::thread(&LevelSaver::run, this);
+}
+
+LevelSaver::~LevelSaver() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+    }
+    wake.notify_all();
+    if (worker.joinable()) worker.join();
+}
+
+void LevelSaver::save(const Level& level, const std::string& path) {
+    Job job;
+    job.path = path;
+    job.snapshot.reset(new Level());
+    level.snapshotTo(*job.snapshot);
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (Job& queued : queue) {
+            if (queued.path == path) {
+                queued.snapshot = std::move(job.snapshot);
+                return;
+            }
+        }
+        queue.push_back(std::move(job));
+    }
+    wake.notify_one();
+}
+
+bool LevelSaver::busy() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return writing || !queue.empty();
+}
+
+void LevelSaver::flush() {
+    std::unique_lock<std::mutex> lock(mtx);
+    idle.wait(lock, [this] { return !writing && queue.empty(); });
+}
+
+bool LevelSaver::poll(Result& out) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (results.empty()) return false;
+    out = std::move(results.front());
+    results.pop_front();
+    return true;
+}
+
+void LevelSaver::run() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            wake.wait(lock, [this] { return stopping || !queue.empty(); });
+            // drain the queue even when stopping
+            if (queue.empty()) return;
+            job = std::move(queue.front());
+            queue.pop_front();
+            writing = true;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        Result res;
+        res.path = job.path;
+        res.ok = job.snapshot->saveToZip(job.path);
+        res.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        job.snapshot.reset();
+
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            writing = false;
+            results.push_back(std::move(res));
+        }
+        idle.notify_all();
+    }
+}
@@ -1,38 +1,49 @@
 #include "MainMenu.h"
-#include <SDL_image.h>
+#include "AssetCache.h"
+#include "Texture.h"
+#include "TextureResidency.h"
 #include <SDL.h>
 #include <vector>
 #include <string>
 
-MainMenu::MainMenu(SDL_Renderer* ren, const std::string& assetsDir) : ren(ren), currentIndex(0) {
+MainMenu::MainMenu(SDL_Renderer* ren, AssetCache& assets, const std::string& assetsDir)
+    : ren(ren), assets(assets), assetsDir(assetsDir), currentIndex(0), pacer(60.0) {
     std::vector<std::string> names = {"1", "2", "3", "4", "5", "6", "7", "8", "9", "mute", "exit", "kill"};
     for (const auto& name : names) {
         std::string path = assetsDir + "menu_glowne_" + name + ".png";
-        SDL_Texture* tex = IMG_LoadTexture(ren, path.c_str());
-        textures.push_back(tex);
-        if (!tex) {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Failed to load %s", path.c_str());
-        }
+        // shared through the cache and decoded in the background:
+        // a screen that isn't ready yet just shows the clear colour
+        assets.prefetch(path);
+        screens.push_back(path);
     }
 }
 
-MainMenu::~MainMenu() {
-    for (auto tex : textures) {
-        if (tex) SDL_DestroyTexture(tex);
-    }
+MainMenu::~MainMenu() = default;
+
+std::string MainMenu::levelBackground(const std::string& assetsDir, int level) {
+    return assetsDir + "poziom_" + std::to_string(level) + "_tlo.jpg";
+}
+
+void MainMenu::prefetchHighlighted() {
+    // entries 0-8 start levels 1-9, "exit" (10) starts level 0
+    if (currentIndex <= 8) assets.prefetch(levelBackground(assetsDir, currentIndex + 1));
+    else if (currentIndex == 10) assets.prefetch(levelBackground(assetsDir, 0));
 }
 
 int MainMenu::run() {
     bool running = true;
+    prefetchHighlighted();
     while (running) {
         SDL_Event ev;
         while (SDL_PollEvent(&ev)) {
             if (ev.type == SDL_QUIT) return -1;
             if (ev.type == SDL_KEYDOWN) {
                 if (ev.key.keysym.scancode == SDL_SCANCODE_LEFT || ev.key.keysym.scancode == SDL_SCANCODE_A) {
-                    currentIndex = (currentIndex - 1 + textures.size()) % textures.size();
+                    currentIndex = (currentIndex - 1 + screens.size()) % screens.size();
+                    prefetchHighlighted();
                 } else if (ev.key.keysym.scancode == SDL_SCANCODE_RIGHT || ev.key.keysym.scancode == SDL_SCANCODE_D) {
-                    currentIndex = (currentIndex + 1) % textures.size();
+                    currentIndex = (currentIndex + 1) % screens.size();
+                    prefetchHighlighted();
                 } else if (ev.key.keysym.scancode == SDL_SCANCODE_RETURN || ev.key.keysym.scancode == SDL_SCANCODE_RETURN2) {
                     if (currentIndex == 9) { // mute
                         SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_INFORMATION, "Menu", "Wyciszono muzykę", nullptr);
@@ -47,12 +58,20 @@ int MainMenu::run() {
             }
         }
 
+        // upload whatever finished decoding since last frame
+        assets.pump();
+
+        // also marks the screen as recently drawn (or starts reloading it if evicted)
+        std::shared_ptr<Texture> shown = assets.textureAsync(screens[currentIndex]);
+
         SDL_RenderClear(ren);
-        if (textures[currentIndex]) {
-            SDL_RenderCopy(ren, textures[currentIndex], nullptr, nullptr);
+        if (shown->tex) {
+            SDL_RenderCopy(ren, shown->tex, nullptr, nullptr);
         }
         SDL_RenderPresent(ren);
-        SDL_Delay(16);
+        shown.reset();
+        if (TextureResidency* budget = assets.residency()) budget->endFrame();
+        pacer.wait();
     }
     return -1;
 }
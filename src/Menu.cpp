@@ -1,47 +1,58 @@
 #include "Menu.h"
+#include "TextureResidency.h"
 #include <SDL.h>
-#include <SDL_ttf.h>
+#include <algorithm>
+#include <utility>
 
-Menu::Menu(SDL_Renderer* renderer, const char* fontPath, int fontSize)
+Menu::Menu(SDL_Renderer* renderer, TextRenderer* text)
 : renderer_(renderer)
+, text_(text)
 {
-    font_ = TTF_OpenFont(fontPath, fontSize);
-    if(!font_){
-        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "TTF_OpenFont failed: %s", TTF_GetError());
-    }
+    if(text_) item_h_ = std::max(item_h_, text_->lineHeight() + 4);
 }
 
 Menu::~Menu(){
-    destroyTextures();
-    if(font_) TTF_CloseFont(font_);
+    untrackAll();
 }
 
-void Menu::createLabelTexture(Item &it){
-    if(!renderer_ || !font_) return;
-    if(it.tex) SDL_DestroyTexture(it.tex);
-    SDL_Surface* surf = TTF_RenderUTF8_Blended(font_, it.label.c_str(), textCol_);
-    if(!surf){
-        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "TTF_RenderUTF8_Blended failed: %s", TTF_GetError());
-        return;
-    }
-    it.tex = SDL_CreateTextureFromSurface(renderer_, surf);
-    it.texW = surf->w;
-    it.texH = surf->h;
-    SDL_FreeSurface(surf);
+void Menu::setResidency(TextureResidency* residency){
+    untrackAll();
+    residency_ = residency;
+    if(!residency_) return;
+    for(size_t i=0;i<items_.size();++i) trackItem(i);
+}
+
+void Menu::trackItem(size_t index){
+    Item &it = items_[index];
+    if(!residency_ || !it.text.texture()) return;
+    // by index: items_ may reallocate, items are never removed
+    it.residencyId = residency_->track("menu label: " + it.label, it.text.bytes(),
+        [this, index](){ items_[index].text.unload(); },
+        [this, index]() -> size_t { items_[index].text.reload(); return items_[index].text.bytes(); });
 }
 
-void Menu::destroyTextures(){
-    for(auto &it : items_){
-        if(it.tex){ SDL_DestroyTexture(it.tex); it.tex = nullptr; }
+void Menu::untrackAll(){
+    if(!residency_) return;
+    for(Item &it : items_){
+        if(it.residencyId >= 0) residency_->untrack(it.residencyId);
+        it.residencyId = -1;
     }
 }
 
+void Menu::createLabelTexture(Item &it){
+    if(!renderer_ || !text_ || !text_->ok()) return;
+    it.text.setRenderer(text_);
+    it.text.setColor(textCol_);
+    it.text.set(it.label);
+}
+
 void Menu::addItem(const std::string &label, std::function<void()> cb){
     Item it;
     it.label = label;
     it.cb = cb;
     createLabelTexture(it);
-    items_.push_back(it);
+    items_.push_back(std::move(it));
+    trackItem(items_.size() - 1);
     if(selected_ >= items_.size()) selected_ = 0;
 }
 
@@ -113,14 +124,9 @@ void Menu::render(){
         }
         // draw label texture if present
         Item &it = items_[i];
-        if(it.tex){
-            SDL_Rect dst{
-                x_ + 8,
-                itemRect.y + (itemRect.h - it.texH)/2,
-                it.texW,
-                it.texH
-            };
-            SDL_RenderCopy(renderer_, it.tex, nullptr, &dst);
+        if(residency_ && it.residencyId >= 0) residency_->use(it.residencyId);
+        if(it.text.texture()){
+            it.text.draw(x_ + 8, itemRect.y + (itemRect.h - it.text.height())/2);
         } else {
             // fallback: draw a small rect when no text available
             SDL_SetRenderDrawColor(renderer_, 120,120,120,200);
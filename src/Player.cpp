@@ -1,16 +1,28 @@
 #include "Player.h"
-#include "Texture.h"
 #include <SDL.h>
 #include <algorithm>
 
+PlayerInput PlayerInput::fromKeyboard(const Uint8* kb){
+    PlayerInput in;
+    if(!kb) return in;
+    in.left = kb[SDL_SCANCODE_LEFT] != 0;
+    in.right = kb[SDL_SCANCODE_RIGHT] != 0;
+    in.jump = kb[SDL_SCANCODE_SPACE] != 0;
+    return in;
+}
+
 void Player::update(double dt, const Uint8* kb){
+    update(dt, PlayerInput::fromKeyboard(kb));
+}
+
+void Player::update(double dt, const PlayerInput& in){
     const float speed = 220.f;
     float vx = 0.f;
     bool moving = false;
-    if(kb[SDL_SCANCODE_LEFT]){ vx -= speed * (float)dt; moving = true; }
-    if(kb[SDL_SCANCODE_RIGHT]){ vx += speed * (float)dt; moving = true; }
+    if(in.left){ vx -= speed * (float)dt; moving = true; }
+    if(in.right){ vx += speed * (float)dt; moving = true; }
     x += vx;
-    if(kb[SDL_SCANCODE_SPACE] && onGround){ vy = -450.f; onGround = false; }
+    if(in.jump && onGround){ vy = -450.f; onGround = false; }
     vy += 1200.f * (float)dt;
     y += vy * (float)dt;
     if(y > 900.f){ y = 900.f; vy = 0.f; onGround = true; }
@@ -46,29 +58,15 @@ void Player::update(double dt, const Uint8* kb){
     }
 }
 
-void Player::render(SDL_Renderer* r, int camX, int camY, float renderScale){
-    if(!r) return;
-    if(frames.empty()) return;
-    Texture* t = frames[curFrame];
-    if(!t || !t->tex) return;
-
-    SDL_SetTextureBlendMode(t->tex, SDL_BLENDMODE_BLEND);
-
-    int srcW = 0, srcH = 0;
-    SDL_QueryTexture(t->tex, nullptr, nullptr, &srcW, &srcH);
-    if (srcH == 0) return;
-
-    int baseW = (width > 0) ? width : srcW;
-    int baseH = (height > 0) ? height : srcH;
-
-    int destW = (int)(baseW * renderScale + 0.5f);
-    int destH = (int)(baseH * renderScale + 0.5f);
+void Player::storePrevious(){
+    prevX = x;
+    prevY = y;
+}
 
-    // Treat y as the player's feet (bottom). Subtract base height before rendering.
-    int dstX = (int)((x - camX) * renderScale + 0.5f);
-    int dstY = (int)((y - camY - baseH) * renderScale + 0.5f);
+float Player::renderX(float alpha) const {
+    return prevX + (x - prevX) * alpha;
+}
 
-    SDL_Rect dst{ dstX, dstY, destW, destH };
-    SDL_RendererFlip flip = facingLeft ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
-    SDL_RenderCopyEx(r, t->tex, nullptr, &dst, 0.0, nullptr, flip);
-}
\ No newline at end of file
+float Player::renderY(float alpha) const {
+    return prevY + (y - prevY) * alpha;
+}
@@ -0,0 +1,28 @@
+#include "Player.h"
+#include <SDL.h>
+
+void Player::render(SDL_Renderer* r, int camX, int camY, float renderScale, float alpha){
+    if(!r) return;
+    if(frames.empty()) return;
+    const SpriteFrame& f = frames[curFrame];
+    if(!f.tex) return;
+
+    // blend mode is set once on the atlas page, size comes from the frame
+    int srcW = f.src.w, srcH = f.src.h;
+    if (srcH == 0) return;
+
+    int baseW = (width > 0) ? width : srcW;
+    int baseH = (height > 0) ? height : srcH;
+
+    int destW = (int)(baseW * renderScale + 0.5f);
+    int destH = (int)(baseH * renderScale + 0.5f);
+
+    // Treat y as the player's feet (bottom). Subtract base height before rendering.
+    // Position is interpolated between the last two sim ticks.
+    int dstX = (int)((renderX(alpha) - camX) * renderScale + 0.5f);
+    int dstY = (int)((renderY(alpha) - camY - baseH) * renderScale + 0.5f);
+
+    SDL_Rect dst{ dstX, dstY, destW, destH };
+    SDL_RendererFlip flip = facingLeft ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
+    SDL_RenderCopyEx(r, f.tex, &f.src, &dst, 0.0, nullptr, flip);
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include "FrameProfiler.h"
+#include "TextRenderer.h"
+#include <algorithm>
+#include <cstdio>
+
+void FrameProfiler::renderOverlay(SDL_Renderer* r, TextRenderer& text, int x, int y) {
+    if (!overlay || !r || !text.ok()) return;
+
+    const int lineH = text.lineHeight();
+    const int panelW = 190;
+    const int graphH = 40;
+    const int rows = PROF_PHASE_COUNT + 2; // header + phases + frame
+    SDL_Rect panel{ x, y, panelW, rows * lineH + graphH + 8 };
+
+    SDL_BlendMode oldBlend = SDL_BLENDMODE_NONE;
+    SDL_GetRenderDrawBlendMode(r, &oldBlend);
+    SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(r, 0, 0, 0, 170);
+    SDL_RenderFillRect(r, &panel);
+
+    const SDL_Color white{ 255, 255, 255, 255 };
+    char line[64];
+    int ty = y + 2;
+    text.draw("phase      avg    p99 ms", x + 4, ty, white);
+    ty += lineH;
+    for (int p = 0; p <= PROF_PHASE_COUNT; ++p) {
+        Stats s = stats(p);
+        std::snprintf(line, sizeof(line), "%-8s %6.2f %6.2f", phaseName(p), s.avg, s.p99);
+        text.draw(line, x + 4, ty, p == PROF_PHASE_COUNT ? SDL_Color{ 255, 220, 80, 255 } : white);
+        ty += lineH;
+    }
+
+    // frame-time graph, newest on the right; guide lines at 60 and 30 fps
+    const int gx = x + 4;
+    const int gy = ty + 2;
+    const int gw = panelW - 8;
+    const double scaleMax = 40.0; // ms at the top of the graph
+    auto yFor = [&](double ms) { return gy + graphH - static_cast<int>(std::min(ms, scaleMax) / scaleMax * graphH); };
+
+    SDL_SetRenderDrawColor(r, 80, 200, 80, 255);
+    SDL_RenderDrawLine(r, gx, yFor(1000.0 / 60.0), gx + gw, yFor(1000.0 / 60.0));
+    SDL_SetRenderDrawColor(r, 200, 80, 80, 255);
+    SDL_RenderDrawLine(r, gx, yFor(1000.0 / 30.0), gx + gw, yFor(1000.0 / 30.0));
+
+    int n = std::min(frameCount(), gw);
+    if (n >= 2) {
+        graphPts.resize(static_cast<size_t>(n));
+        for (int i = 0; i < n; ++i) {
+            graphPts[static_cast<size_t>(i)] = SDL_Point{ gx + gw - 1 - i, yFor(frameMs(i)) };
+        }
+        SDL_SetRenderDrawColor(r, 255, 255, 255, 255);
+        SDL_RenderDrawLines(r, graphPts.data(), n);
+    }
+    SDL_SetRenderDrawBlendMode(r, oldBlend);
+}
@@ -0,0 +1,163 @@
+#include "Simulation.h"
+#include "Level.h"
+#include "Collision.h"
+#include "FrameProfiler.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+const uint64_t kFnvOffset = 1469598103934665603ull;
+const uint64_t kFnvPrime = 1099511628211ull;
+
+void hashBytes(uint64_t& h, const void* data, size_t n) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < n; ++i) {
+        h ^= p[i];
+        h *= kFnvPrime;
+    }
+}
+
+template <typename T>
+void hashValue(uint64_t& h, T v) {
+    hashBytes(h, &v, sizeof(v));
+}
+
+template <typename T>
+void hashColumn(uint64_t& h, const std::vector<T>& col) {
+    if (!col.empty()) hashBytes(h, col.data(), col.size() * sizeof(T));
+}
+}
+
+Simulation::Simulation(Level& l, Player& p, int cellSize)
+    : level(l)
+    , player(p)
+    , cell(std::max(1, cellSize))
+    , isPaused(false)
+    , swept(true)
+    , profiler(nullptr)
+    , playerLost(false)
+    , playerWon(false)
+{
+}
+
+void Simulation::tick(const PlayerInput& input, double dt) {
+    player.storePrevious();
+    actorStore.storePrevious();
+
+    int levelW = levelWidth();
+    int levelH = levelHeight();
+
+    if (!isPaused && !finished()) {
+        {
+            FrameProfiler::Scope ps(profiler, PROF_PLAYER_UPDATE);
+            player.update(dt, input);
+        }
+        {
+            FrameProfiler::Scope ps(profiler, PROF_COLLISIONS);
+            // sweep the whole step first; the push-out pass then only handles
+            // tiles that appeared on top of the player (editor) and pickups
+            if (swept) movePlayerSwept(player, level, player.prevX, player.prevY, cell, cell);
+            resolvePlayerCollisions(player, level, cell, cell);
+        }
+
+        if (actorStore.size() > 0) {
+            FrameProfiler::Scope ps(profiler, PROF_ACTORS);
+            float fdt = static_cast<float>(dt);
+            actorStore.integrate(fdt);
+            actorStore.resolveTiles(level, cell);
+            actorStore.animate(fdt);
+            // anything that left the level (fell out, flew off) is gone
+            actorStore.killOutside(-static_cast<float>(cell), -static_cast<float>(levelH),
+                                   static_cast<float>(levelW + cell), static_cast<float>(levelH + cell));
+            // reclaim storage once a quarter of the slots are dead
+            if ((actorStore.size() - actorStore.aliveCount()) * 4 > actorStore.size()) actorStore.compact();
+        }
+
+        // Check for game over conditions
+        if (player.health <= 0) playerLost = true;
+        if (player.x >= levelW - player.width) playerWon = true;
+    }
+
+    // clamp player to level bounds (physics units)
+    if (levelW > 0) {
+        if (player.x < 0.f) player.x = 0.f;
+        float maxPlayerX = (float)std::max(0, levelW - player.width);
+        if (player.x > maxPlayerX) player.x = maxPlayerX;
+    }
+    if (levelH > 0) {
+        if (player.y < 0.f) player.y = 0.f;
+        float maxPlayerY = (float)std::max(0, levelH - player.height);
+        if (player.y > maxPlayerY) { player.y = maxPlayerY; player.onGround = true; player.vy = 0.f; }
+    }
+}
+
+void Simulation::setPaused(bool p) {
+    isPaused = p;
+}
+
+bool Simulation::paused() const {
+    return isPaused;
+}
+
+void Simulation::setSweptCollision(bool on) {
+    swept = on;
+}
+
+bool Simulation::sweptCollision() const {
+    return swept;
+}
+
+void Simulation::setProfiler(FrameProfiler* p) {
+    profiler = p;
+}
+
+bool Simulation::lost() const {
+    return playerLost;
+}
+
+bool Simulation::won() const {
+    return playerWon;
+}
+
+bool Simulation::finished() const {
+    return playerLost || playerWon;
+}
+
+uint64_t Simulation::checksum() const {
+    uint64_t h = kFnvOffset;
+    hashValue(h, player.x);
+    hashValue(h, player.y);
+    hashValue(h, player.vy);
+    hashValue(h, player.invulnTimer);
+    hashValue(h, player.health);
+    hashValue(h, player.score);
+    hashValue<uint8_t>(h, (player.onGround ? 1 : 0) | (player.facingLeft ? 2 : 0) |
+                          (playerLost ? 4 : 0) | (playerWon ? 8 : 0));
+    hashValue(h, actorStore.size());
+    hashColumn(h, actorStore.x);
+    hashColumn(h, actorStore.y);
+    hashColumn(h, actorStore.vx);
+    hashColumn(h, actorStore.vy);
+    hashColumn(h, actorStore.flags);
+    return h;
+}
+
+ActorStore& Simulation::actors() {
+    return actorStore;
+}
+
+const ActorStore& Simulation::actors() const {
+    return actorStore;
+}
+
+int Simulation::cellSize() const {
+    return cell;
+}
+
+int Simulation::levelWidth() const {
+    return level.cols() * cell;
+}
+
+int Simulation::levelHeight() const {
+    return level.rows() * cell;
+}
@@ -0,0 +1,159 @@
+#include "SpriteAtlas.h"
+#include "Texture.h"
+#include <algorithm>
+
+namespace {
+const int kPad = 1; // transparent gap so linear filtering doesn't bleed
+
+// Smallest power of two >= v
+int pow2(int v) {
+    int p = 1;
+    while (p < v) p <<= 1;
+    return p;
+}
+}
+
+SpriteAtlas::SpriteAtlas() = default;
+
+SpriteAtlas::~SpriteAtlas() {
+    destroyPages();
+}
+
+int SpriteAtlas::add(const std::string& path) {
+    Entry e;
+    e.path = path;
+    entries.push_back(e);
+    return static_cast<int>(entries.size()) - 1;
+}
+
+bool SpriteAtlas::build(SDL_Renderer* ren, int maxSize) {
+    if (!ren) return false;
+    destroyPages();
+
+    SDL_RendererInfo info;
+    if (SDL_GetRendererInfo(ren, &info) == 0 && info.max_texture_width > 0) {
+        maxSize = std::min(maxSize, std::min(info.max_texture_width, info.max_texture_height));
+    }
+
+    // decode everything first (CPU side)
+    std::vector<SDL_Surface*> surfs(entries.size(), nullptr);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        entries[i].region = SpriteFrame();
+        surfs[i] = Texture::decode(entries[i].path);
+        if (surfs[i] && (surfs[i]->w + kPad > maxSize || surfs[i]->h + kPad > maxSize)) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "SpriteAtlas: %s (%dx%d) exceeds max atlas size %d", entries[i].path.c_str(),
+                    surfs[i]->w, surfs[i]->h, maxSize);
+            SDL_FreeSurface(surfs[i]);
+            surfs[i] = nullptr;
+        }
+    }
+
+    // shelf packing, tallest first; a new page starts when one fills up
+    std::vector<size_t> order;
+    for (size_t i = 0; i < surfs.size(); ++i) {
+        if (surfs[i]) order.push_back(i);
+    }
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return surfs[a]->h > surfs[b]->h; });
+
+    // page width: enough for a roughly square layout, capped at maxSize
+    long long area = 0;
+    int widest = 0;
+    for (size_t i : order) {
+        area += static_cast<long long>(surfs[i]->w + kPad) * (surfs[i]->h + kPad);
+        widest = std::max(widest, surfs[i]->w + kPad);
+    }
+    int pageW = 1;
+    while (static_cast<long long>(pageW) * pageW < area) pageW <<= 1;
+    pageW = std::min(maxSize, std::max(pow2(widest), pageW));
+
+    struct Placement { size_t entry; int page; SDL_Rect rect; };
+    std::vector<Placement> placed;
+    std::vector<int> pageHeights;
+    int page = 0, penX = 0, penY = 0, shelfH = 0;
+    pageHeights.push_back(0);
+    for (size_t i : order) {
+        int w = surfs[i]->w;
+        int h = surfs[i]->h;
+        if (penX + w + kPad > pageW) {
+            penX = 0;
+            penY += shelfH;
+            shelfH = 0;
+        }
+        if (penY + h + kPad > maxSize) {
+            ++page;
+            pageHeights.push_back(0);
+            penX = penY = shelfH = 0;
+        }
+        placed.push_back(Placement{ i, page, SDL_Rect{ penX, penY, w, h } });
+        penX += w + kPad;
+        shelfH = std::max(shelfH, h + kPad);
+        pageHeights[page] = std::max(pageHeights[page], penY + h);
+    }
+
+    // compose each page on the CPU and upload it once
+    bool ok = true;
+    for (int p = 0; p < static_cast<int>(pageHeights.size()) && !placed.empty(); ++p) {
+        int pageH = pow2(std::max(1, pageHeights[p]));
+        SDL_Surface* canvas = SDL_CreateRGBSurfaceWithFormat(0, pageW, pageH, 32, SDL_PIXELFORMAT_RGBA32);
+        if (!canvas) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "SpriteAtlas: page surface failed: %s", SDL_GetError());
+            ok = false;
+            break;
+        }
+        for (const Placement& pl : placed) {
+            if (pl.page != p) continue;
+            SDL_Rect dst = pl.rect;
+            SDL_SetSurfaceBlendMode(surfs[pl.entry], SDL_BLENDMODE_NONE); // copy alpha as-is
+            SDL_BlitSurface(surfs[pl.entry], nullptr, canvas, &dst);
+        }
+        SDL_Texture* tex = SDL_CreateTextureFromSurface(ren, canvas);
+        SDL_FreeSurface(canvas);
+        if (!tex) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "SpriteAtlas: page upload failed: %s", SDL_GetError());
+            ok = false;
+            break;
+        }
+        SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND); // once, not per draw
+        pages.push_back(tex);
+    }
+
+    for (const Placement& pl : placed) {
+        if (pl.page >= static_cast<int>(pages.size())) continue;
+        SpriteFrame& f = entries[pl.entry].region;
+        f.tex = pages[pl.page];
+        f.src = pl.rect;
+    }
+    for (SDL_Surface* s : surfs) {
+        if (s) SDL_FreeSurface(s);
+    }
+
+    SDL_Log("DBG: sprite atlas: %d frames on %d page(s), %dpx wide", frameCount(), pageCount(), pageW);
+    return ok && complete();
+}
+
+SpriteFrame SpriteAtlas::frame(int id) const {
+    if (id < 0 || id >= static_cast<int>(entries.size())) return SpriteFrame();
+    return entries[id].region;
+}
+
+int SpriteAtlas::frameCount() const {
+    return static_cast<int>(entries.size());
+}
+
+int SpriteAtlas::pageCount() const {
+    return static_cast<int>(pages.size());
+}
+
+bool SpriteAtlas::complete() const {
+    for (const Entry& e : entries) {
+        if (!e.region.tex) return false;
+    }
+    return true;
+}
+
+void SpriteAtlas::destroyPages() {
+    for (SDL_Texture* t : pages) {
+        if (t) SDL_DestroyTexture(t);
+    }
+    pages.clear();
+}
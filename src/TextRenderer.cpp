@@ -0,0 +1,359 @@
+#include "TextRenderer.h"
+#include "AssetArchive.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+const int kAtlasW = 512;
+const int kAtlasH = 512;
+const int kGlyphPad = 1;
+const uint32_t kReplacement = 0xFFFD;
+
+// Polish letters, preloaded so the HUD/menus never rasterize mid-game
+const uint32_t kPolish[] = {
+    0x104, 0x105, 0x106, 0x107, 0x118, 0x119, 0x141, 0x142, 0x143,
+    0x144, 0xD3, 0xF3, 0x15A, 0x15B, 0x179, 0x17A, 0x17B, 0x17C
+};
+}
+
+TextRenderer::TextRenderer(SDL_Renderer* renderer, const std::string& fontPath, int ptSize, bool glyphAtlas)
+    : ren(renderer)
+    , fnt(nullptr)
+    , useAtlas(glyphAtlas)
+    , atlas(nullptr)
+    , atlasW(kAtlasW)
+    , atlasH(kAtlasH)
+    , penX(0)
+    , penY(0)
+    , shelfH(0)
+{
+    // the archive mapping outlives every font, so the font can read from it directly
+    SDL_RWops* rw = AssetArchive::openFile(fontPath);
+    fnt = rw ? TTF_OpenFontRW(rw, 1, ptSize) : nullptr;
+    if (!fnt) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "TTF_OpenFont failed for %s: %s", fontPath.c_str(), TTF_GetError());
+        return;
+    }
+    if (!useAtlas || !createAtlas()) return;
+
+    for (uint32_t cp = 32; cp < 127; ++cp) glyph(cp);
+    for (uint32_t cp : kPolish) glyph(cp);
+}
+
+TextRenderer::~TextRenderer() {
+    if (atlas) SDL_DestroyTexture(atlas);
+    if (fnt) TTF_CloseFont(fnt);
+}
+
+bool TextRenderer::ok() const {
+    return fnt != nullptr && (atlas != nullptr || !useAtlas);
+}
+
+TTF_Font* TextRenderer::font() const {
+    return fnt;
+}
+
+SDL_Renderer* TextRenderer::renderer() const {
+    return ren;
+}
+
+int TextRenderer::lineHeight() const {
+    return fnt ? TTF_FontLineSkip(fnt) : 0;
+}
+
+size_t TextRenderer::textureBytes() const {
+    return atlas ? static_cast<size_t>(atlasW) * atlasH * 4 : 0;
+}
+
+uint32_t TextRenderer::nextCodepoint(const std::string& s, size_t& i) {
+    unsigned char c = static_cast<unsigned char>(s[i++]);
+    if (c < 0x80) return c;
+
+    int extra = 0;
+    uint32_t cp = 0;
+    if ((c & 0xE0) == 0xC0) { extra = 1; cp = c & 0x1F; }
+    else if ((c & 0xF0) == 0xE0) { extra = 2; cp = c & 0x0F; }
+    else if ((c & 0xF8) == 0xF0) { extra = 3; cp = c & 0x07; }
+    else return kReplacement;
+
+    for (int k = 0; k < extra; ++k) {
+        if (i >= s.size()) return kReplacement;
+        unsigned char cc = static_cast<unsigned char>(s[i]);
+        if ((cc & 0xC0) != 0x80) return kReplacement;
+        cp = (cp << 6) | (cc & 0x3F);
+        ++i;
+    }
+    return cp;
+}
+
+void TextRenderer::draw(const std::string& utf8, int x, int y, SDL_Color color) {
+    if (!ok() || !atlas || !ren || utf8.empty()) return;
+
+    verts.clear();
+    indices.clear();
+
+    int lineSkip = lineHeight();
+    int penXText = x;
+    int penYText = y;
+    size_t i = 0;
+    while (i < utf8.size()) {
+        uint32_t cp = nextCodepoint(utf8, i);
+        if (cp == '\n') {
+            penXText = x;
+            penYText += lineSkip;
+            continue;
+        }
+        const Glyph& g = glyph(cp);
+        if (!g.valid) continue;
+
+        if (g.src.w > 0 && g.src.h > 0) {
+            float x0 = static_cast<float>(penXText);
+            float y0 = static_cast<float>(penYText);
+            float x1 = x0 + g.src.w;
+            float y1 = y0 + g.src.h;
+            float u0 = static_cast<float>(g.src.x) / atlasW;
+            float v0 = static_cast<float>(g.src.y) / atlasH;
+            float u1 = static_cast<float>(g.src.x + g.src.w) / atlasW;
+            float v1 = static_cast<float>(g.src.y + g.src.h) / atlasH;
+
+            int base = static_cast<int>(verts.size());
+            verts.push_back(SDL_Vertex{ {x0, y0}, color, {u0, v0} });
+            verts.push_back(SDL_Vertex{ {x1, y0}, color, {u1, v0} });
+            verts.push_back(SDL_Vertex{ {x1, y1}, color, {u1, v1} });
+            verts.push_back(SDL_Vertex{ {x0, y1}, color, {u0, v1} });
+            indices.insert(indices.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+        }
+        penXText += g.advance;
+    }
+    if (verts.empty()) return;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    SDL_RenderGeometry(ren, atlas, verts.data(), static_cast<int>(verts.size()),
+                       indices.data(), static_cast<int>(indices.size()));
+#else
+    // pre-2.0.18 SDL: one copy per glyph quad
+    SDL_SetTextureColorMod(atlas, color.r, color.g, color.b);
+    SDL_SetTextureAlphaMod(atlas, color.a);
+    for (size_t q = 0; q + 3 < verts.size(); q += 4) {
+        SDL_Rect src{ static_cast<int>(verts[q].tex_coord.x * atlasW), static_cast<int>(verts[q].tex_coord.y * atlasH),
+                      static_cast<int>(verts[q + 2].position.x - verts[q].position.x),
+                      static_cast<int>(verts[q + 2].position.y - verts[q].position.y) };
+        SDL_Rect dst{ static_cast<int>(verts[q].position.x), static_cast<int>(verts[q].position.y), src.w, src.h };
+        SDL_RenderCopy(ren, atlas, &src, &dst);
+    }
+    SDL_SetTextureColorMod(atlas, 255, 255, 255);
+    SDL_SetTextureAlphaMod(atlas, 255);
+#endif
+}
+
+void TextRenderer::measure(const std::string& utf8, int* w, int* h) {
+    int lineSkip = lineHeight();
+    int maxW = 0;
+    int lineW = 0;
+    int lines = utf8.empty() ? 0 : 1;
+    size_t i = 0;
+    while (i < utf8.size()) {
+        uint32_t cp = nextCodepoint(utf8, i);
+        if (cp == '\n') {
+            maxW = std::max(maxW, lineW);
+            lineW = 0;
+            ++lines;
+            continue;
+        }
+        const Glyph& g = glyph(cp);
+        if (g.valid) lineW += g.advance;
+    }
+    maxW = std::max(maxW, lineW);
+    if (w) *w = maxW;
+    if (h) *h = lines * lineSkip;
+}
+
+const TextRenderer::Glyph& TextRenderer::glyph(uint32_t cp) {
+    static const Glyph kMissing;
+    if (!ok()) return kMissing;
+
+    if (cp < 128) {
+        Glyph& g = ascii[cp];
+        if (!g.valid) addGlyph(cp, g);
+        return g;
+    }
+    auto it = glyphs.find(cp);
+    if (it != glyphs.end()) return it->second;
+
+    Glyph& g = glyphs[cp];
+    if (!addGlyph(cp, g) && cp != kReplacement) {
+        // fall back to the replacement glyph (or '?') for unsupported code points
+        const Glyph& r = glyph(TTF_GlyphIsProvided32(fnt, kReplacement) ? kReplacement : static_cast<uint32_t>('?'));
+        glyphs[cp] = r;
+        return glyphs[cp];
+    }
+    return g;
+}
+
+bool TextRenderer::addGlyph(uint32_t cp, Glyph& g) {
+    g = Glyph();
+    if (!TTF_GlyphIsProvided32(fnt, cp)) return false;
+
+    int minx = 0, maxx = 0, miny = 0, maxy = 0, advance = 0;
+    if (TTF_GlyphMetrics32(fnt, cp, &minx, &maxx, &miny, &maxy, &advance) != 0) return false;
+    g.advance = advance;
+    g.valid = true;
+    if (!atlas) return true; // metrics only, for measure()
+
+    // white glyph; colour comes from vertex colour / colour mod at draw time
+    SDL_Surface* surf = TTF_RenderGlyph32_Blended(fnt, cp, SDL_Color{255, 255, 255, 255});
+    if (!surf) return true; // e.g. space: advance only
+    SDL_Surface* conv = SDL_ConvertSurfaceFormat(surf, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDL_FreeSurface(surf);
+    if (!conv) return true;
+
+    int gw = conv->w;
+    int gh = conv->h;
+    if (penX + gw + kGlyphPad > atlasW) {
+        penX = 0;
+        penY += shelfH + kGlyphPad;
+        shelfH = 0;
+    }
+    if (gw + kGlyphPad > atlasW || penY + gh + kGlyphPad > atlasH) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Glyph atlas full, U+%04X not cached", static_cast<unsigned>(cp));
+        SDL_FreeSurface(conv);
+        return true;
+    }
+
+    SDL_Rect dst{ penX, penY, gw, gh };
+    SDL_UpdateTexture(atlas, &dst, conv->pixels, conv->pitch);
+    SDL_FreeSurface(conv);
+
+    g.src = dst;
+    penX += gw + kGlyphPad;
+    shelfH = std::max(shelfH, gh);
+    return true;
+}
+
+bool TextRenderer::createAtlas() {
+    if (!ren) return false;
+    atlas = SDL_CreateTexture(ren, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, atlasW, atlasH);
+    if (!atlas) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Glyph atlas creation failed: %s", SDL_GetError());
+        return false;
+    }
+    SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND);
+    // texture memory starts undefined; clear it so padding stays transparent
+    std::vector<Uint32> zeros(static_cast<size_t>(atlasW) * atlasH, 0);
+    SDL_UpdateTexture(atlas, nullptr, zeros.data(), atlasW * 4);
+    return true;
+}
+
+CachedText::CachedText(TextRenderer* text, SDL_Color color)
+    : owner(text)
+    , col(color)
+    , tex(nullptr)
+    , w(0)
+    , h(0)
+{
+}
+
+CachedText::~CachedText() {
+    release();
+}
+
+CachedText::CachedText(CachedText&& other) noexcept
+    : owner(other.owner)
+    , str(std::move(other.str))
+    , col(other.col)
+    , tex(other.tex)
+    , w(other.w)
+    , h(other.h)
+{
+    other.tex = nullptr;
+    other.w = other.h = 0;
+}
+
+CachedText& CachedText::operator=(CachedText&& other) noexcept {
+    if (this != &other) {
+        release();
+        owner = other.owner;
+        str = std::move(other.str);
+        col = other.col;
+        tex = other.tex;
+        w = other.w;
+        h = other.h;
+        other.tex = nullptr;
+        other.w = other.h = 0;
+    }
+    return *this;
+}
+
+void CachedText::setRenderer(TextRenderer* text) {
+    if (owner == text) return;
+    owner = text;
+    rebuild();
+}
+
+bool CachedText::set(const std::string& utf8) {
+    if (tex && utf8 == str) return false;
+    str = utf8;
+    rebuild();
+    return true;
+}
+
+void CachedText::setColor(SDL_Color color) {
+    if (color.r == col.r && color.g == col.g && color.b == col.b && color.a == col.a) return;
+    col = color;
+    rebuild();
+}
+
+void CachedText::draw(int x, int y) const {
+    if (!tex || !owner) return;
+    SDL_Rect dst{ x, y, w, h };
+    SDL_RenderCopy(owner->renderer(), tex, nullptr, &dst);
+}
+
+const std::string& CachedText::text() const {
+    return str;
+}
+
+SDL_Texture* CachedText::texture() const {
+    return tex;
+}
+
+int CachedText::width() const {
+    return w;
+}
+
+int CachedText::height() const {
+    return h;
+}
+
+size_t CachedText::bytes() const {
+    return tex ? static_cast<size_t>(w) * h * 4 : 0;
+}
+
+void CachedText::unload() {
+    release();
+}
+
+void CachedText::reload() {
+    rebuild();
+}
+
+void CachedText::rebuild() {
+    release();
+    if (!owner || !owner->font() || !owner->renderer() || str.empty()) return;
+
+    SDL_Surface* surf = TTF_RenderUTF8_Blended(owner->font(), str.c_str(), col);
+    if (!surf) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "TTF_RenderUTF8_Blended failed: %s", TTF_GetError());
+        return;
+    }
+    tex = SDL_CreateTextureFromSurface(owner->renderer(), surf);
+    w = surf->w;
+    h = surf->h;
+    SDL_FreeSurface(surf);
+}
+
+void CachedText::release() {
+    if (tex) SDL_DestroyTexture(tex);
+    tex = nullptr;
+    w = h = 0;
+}
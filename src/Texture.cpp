@@ -1,62 +1,153 @@
 #include "Texture.h"
+#include "AssetArchive.h"
+#include "ImageResample.h"
 #include <SDL.h>
 #include <SDL_image.h>
 #include <string>
 #include <iostream>
 
+namespace {
+// New RGBA32 surface holding src resampled to w x h; null on failure
+SDL_Surface* resampled(SDL_Surface* src, int w, int h) {
+    SDL_Surface* dst = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!dst) return nullptr;
+    ImageResample::resize(static_cast<const uint8_t*>(src->pixels), src->w, src->h, src->pitch,
+                          static_cast<uint8_t*>(dst->pixels), dst->w, dst->h, dst->pitch);
+    return dst;
+}
+}
+
 Texture::~Texture() {
-    if (tex) {
-        SDL_DestroyTexture(tex);
-        tex = nullptr;
-    }
+    unload();
 }
 
-bool Texture::load(SDL_Renderer* renderer, const std::string& path) {
+void Texture::unload() {
+    for (Level& l : levels) SDL_DestroyTexture(l.tex);
+    levels.clear();
+    tex = nullptr;
+    w = h = 0;
+}
+
+bool Texture::load(SDL_Renderer* renderer, const std::string& path, const TextureFit& fit) {
     if (!renderer) return false;
 
-    if (tex) {
-        SDL_DestroyTexture(tex);
-        tex = nullptr;
-        w = h = 0;
+    std::vector<SDL_Surface*> decoded;
+    if (!decode(path, fit, decoded)) {
+        unload();
+        return false;
     }
+    bool ok = upload(renderer, decoded, path);
+    for (SDL_Surface* s : decoded) SDL_FreeSurface(s);
+    return ok;
+}
 
-    SDL_Surface* surf = IMG_Load(path.c_str());
+SDL_Surface* Texture::decode(const std::string& path) {
+    // packed archive when mounted (zero-copy from the mapping), else the loose file
+    SDL_RWops* rw = AssetArchive::openFile(path);
+    SDL_Surface* surf = rw ? IMG_Load_RW(rw, 1) : nullptr;
     if (!surf) {
         SDL_Log("IMG_Load failed for %s: %s", path.c_str(), IMG_GetError());
-        return false;
+        return nullptr;
     }
 
     SDL_Surface* conv = SDL_ConvertSurfaceFormat(surf, SDL_PIXELFORMAT_RGBA32, 0);
     SDL_FreeSurface(surf);
     if (!conv) {
         SDL_Log("SDL_ConvertSurfaceFormat failed for %s: %s", path.c_str(), SDL_GetError());
-        return false;
+        return nullptr;
     }
+    return conv;
+}
 
-    SDL_Texture* newTex = SDL_CreateTextureFromSurface(renderer, conv);
-    if (!newTex) {
-        SDL_Log("SDL_CreateTextureFromSurface failed for %s: %s", path.c_str(), SDL_GetError());
-        SDL_FreeSurface(conv);
-        return false;
+bool Texture::decode(const std::string& path, const TextureFit& fit, std::vector<SDL_Surface*>& levels) {
+    levels.clear();
+    SDL_Surface* full = decode(path);
+    if (!full) return false;
+
+    int fw = 0, fh = 0;
+    ImageResample::fitHeight(full->w, full->h, fit.maxHeight, fw, fh);
+    const bool shrunk = fw != full->w || fh != full->h;
+    if (shrunk) {
+        SDL_Surface* fitted = resampled(full, fw, fh);
+        if (fitted) {
+            SDL_Log("DBG: %s resampled %dx%d -> %dx%d", path.c_str(), full->w, full->h, fw, fh);
+            SDL_FreeSurface(full);
+            full = fitted;
+        } else {
+            SDL_Log("Resampling %s failed, keeping full size: %s", path.c_str(), SDL_GetError());
+        }
+    }
+    levels.push_back(full);
+
+    // each mip from the previous level: a 2:1 step keeps the filter cheap
+    for (int i = 1; shrunk && i < fit.mipLevels; ++i) {
+        SDL_Surface* prev = levels.back();
+        if (prev->w <= 1 && prev->h <= 1) break;
+        if ((prev->h + 1) / 2 < fit.minMipHeight) break; // never selectable
+        SDL_Surface* mip = resampled(prev, (prev->w + 1) / 2, (prev->h + 1) / 2);
+        if (!mip) break;
+        levels.push_back(mip);
     }
+    return true;
+}
+
+bool Texture::upload(SDL_Renderer* renderer, SDL_Surface* conv, const std::string& path) {
+    if (!conv) return false;
+    return upload(renderer, std::vector<SDL_Surface*>{ conv }, path);
+}
+
+bool Texture::upload(SDL_Renderer* renderer, const std::vector<SDL_Surface*>& surfs, const std::string& path) {
+    if (!renderer || surfs.empty() || !surfs.front()) return false;
+
+    unload();
 
-    SDL_SetTextureBlendMode(newTex, SDL_BLENDMODE_BLEND);
+    for (SDL_Surface* s : surfs) {
+        SDL_Texture* newTex = SDL_CreateTextureFromSurface(renderer, s);
+        if (!newTex) {
+            SDL_Log("SDL_CreateTextureFromSurface failed for %s: %s", path.c_str(), SDL_GetError());
+            // a partial chain still works; nothing at all is a failure
+            if (levels.empty()) return false;
+            break;
+        }
+        SDL_SetTextureBlendMode(newTex, SDL_BLENDMODE_BLEND);
 
-    int texW = 0, texH = 0;
-    if (SDL_QueryTexture(newTex, nullptr, nullptr, &texW, &texH) != 0) {
-        SDL_Log("SDL_QueryTexture failed for %s: %s", path.c_str(), SDL_GetError());
+        int texW = 0, texH = 0;
+        if (SDL_QueryTexture(newTex, nullptr, nullptr, &texW, &texH) != 0) {
+            SDL_Log("SDL_QueryTexture failed for %s: %s", path.c_str(), SDL_GetError());
+        }
+        levels.push_back(Level{ newTex, texW, texH });
     }
 
-    tex = newTex;
-    w = texW;
-    h = texH;
+    tex = levels.front().tex;
+    w = levels.front().w;
+    h = levels.front().h;
 
-    SDL_FreeSurface(conv);
+    if (levels.size() > 1) SDL_Log("DBG: Texture loaded: %s (%dx%d, %zu levels)", path.c_str(), w, h, levels.size());
+    else SDL_Log("DBG: Texture loaded: %s (%dx%d)", path.c_str(), w, h);
+    return true;
+}
 
-    SDL_Log("DBG: Texture loaded: %s (%dx%d)", path.c_str(), w, h);
+bool Texture::selectLevel(int displayHeight) {
+    if (levels.empty()) return false;
+    size_t pick = 0;
+    for (size_t i = 1; i < levels.size() && levels[i].h >= displayHeight; ++i) pick = i;
+    if (levels[pick].tex == tex) return false;
+    tex = levels[pick].tex;
+    w = levels[pick].w;
+    h = levels[pick].h;
     return true;
 }
 
+int Texture::levelCount() const {
+    return static_cast<int>(levels.size());
+}
+
+size_t Texture::bytes() const {
+    size_t total = 0;
+    for (const Level& l : levels) total += static_cast<size_t>(l.w) * l.h * 4;
+    return total;
+}
+
 void Texture::draw(SDL_Renderer* renderer, int x, int y, int drawW, int drawH) {
     if (!renderer || !tex) return;
 
@@ -67,4 +158,4 @@ void Texture::draw(SDL_Renderer* renderer, int x, int y, int drawW, int drawH) {
 
     SDL_Rect dst{ x, y, dstW, dstH };
     SDL_RenderCopy(renderer, tex, nullptr, &dst);
-}
\ No newline at end of file
+}
@@ -0,0 +1,164 @@
+#include "TextureResidency.h"
+#include <SDL.h>
+#include <algorithm>
+
+TextureResidency::TextureResidency(size_t budget)
+    : budgetBytes(budget)
+    , residentBytes(0)
+    , peakBytes(0)
+    , frame(1)
+    , evictCount(0)
+    , reloadCount(0)
+    , reloadFailCount(0)
+{
+}
+
+void TextureResidency::setBudget(size_t bytes) {
+    budgetBytes = bytes;
+    enforce();
+}
+
+size_t TextureResidency::budget() const {
+    return budgetBytes;
+}
+
+TextureResidency::Entry* TextureResidency::entry(int id) {
+    if (id < 0 || id >= static_cast<int>(entries.size()) || !entries[id].live) return nullptr;
+    return &entries[id];
+}
+
+const TextureResidency::Entry* TextureResidency::entry(int id) const {
+    if (id < 0 || id >= static_cast<int>(entries.size()) || !entries[id].live) return nullptr;
+    return &entries[id];
+}
+
+int TextureResidency::track(const std::string& name, size_t bytes, EvictFn evict, ReloadFn reload, CanEvictFn canEvict) {
+    int id;
+    if (!freeIds.empty()) {
+        id = freeIds.back();
+        freeIds.pop_back();
+    } else {
+        id = static_cast<int>(entries.size());
+        entries.emplace_back();
+    }
+    Entry& e = entries[id];
+    e = Entry();
+    e.name = name;
+    e.bytes = bytes;
+    e.lastUse = frame; // just loaded: counts as used, so it can't be evicted this frame
+    e.live = true;
+    e.resident = true;
+    e.evict = std::move(evict);
+    e.reload = std::move(reload);
+    e.canEvict = std::move(canEvict);
+    residentBytes += bytes;
+    peakBytes = std::max(peakBytes, residentBytes);
+    enforce();
+    return id;
+}
+
+void TextureResidency::untrack(int id) {
+    Entry* e = entry(id);
+    if (!e) return;
+    if (e->resident) residentBytes -= e->bytes;
+    *e = Entry();
+    freeIds.push_back(id);
+}
+
+void TextureResidency::setResident(int id, size_t bytes) {
+    Entry* e = entry(id);
+    if (!e) return;
+    if (e->resident) residentBytes -= e->bytes;
+    else ++reloadCount;
+    e->bytes = bytes;
+    e->resident = true;
+    e->lastUse = frame;
+    residentBytes += bytes;
+    peakBytes = std::max(peakBytes, residentBytes);
+    enforce();
+}
+
+void TextureResidency::setPinned(int id, bool pinned) {
+    if (Entry* e = entry(id)) e->pinned = pinned;
+}
+
+bool TextureResidency::use(int id) {
+    Entry* e = entry(id);
+    if (!e) return false;
+    e->lastUse = frame;
+    if (e->resident) return true;
+
+    size_t bytes = e->reload ? e->reload() : 0;
+    e = entry(id); // the reload callback may have touched the registry
+    if (!e) return false;
+    if (bytes == 0) {
+        ++reloadFailCount;
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Texture reload failed: %s", e->name.c_str());
+        return false;
+    }
+    ++reloadCount;
+    e->bytes = bytes;
+    e->resident = true;
+    residentBytes += bytes;
+    peakBytes = std::max(peakBytes, residentBytes);
+    enforce();
+    return true;
+}
+
+bool TextureResidency::resident(int id) const {
+    const Entry* e = entry(id);
+    return e && e->resident;
+}
+
+void TextureResidency::endFrame() {
+    enforce();
+    ++frame;
+}
+
+void TextureResidency::enforce() {
+    if (budgetBytes == 0 || residentBytes <= budgetBytes) return;
+
+    // oldest first; anything used this frame may be on screen right now
+    std::vector<int> order;
+    for (int i = 0; i < static_cast<int>(entries.size()); ++i) {
+        const Entry& e = entries[i];
+        if (e.live && e.resident && !e.pinned && e.lastUse < frame) order.push_back(i);
+    }
+    std::sort(order.begin(), order.end(), [&](int a, int b) { return entries[a].lastUse < entries[b].lastUse; });
+
+    for (int id : order) {
+        if (residentBytes <= budgetBytes) break;
+        Entry& e = entries[id];
+        if (e.canEvict && !e.canEvict()) continue;
+        if (e.evict) e.evict();
+        e.resident = false;
+        residentBytes -= e.bytes;
+        ++evictCount;
+    }
+}
+
+TextureResidency::Stats TextureResidency::stats() const {
+    Stats s;
+    s.budget = budgetBytes;
+    s.residentBytes = residentBytes;
+    s.peakBytes = peakBytes;
+    s.evictions = evictCount;
+    s.reloads = reloadCount;
+    s.reloadFailures = reloadFailCount;
+    for (const Entry& e : entries) {
+        if (!e.live) continue;
+        if (e.resident) ++s.resident;
+        else ++s.evicted;
+        if (e.pinned) ++s.pinned;
+    }
+    return s;
+}
+
+void TextureResidency::logStats() const {
+    Stats s = stats();
+    SDL_Log("DBG: textures: %.1f / %.1f MB resident (peak %.1f), %d resident, %d evicted, %d pinned, "
+            "%llu evictions, %llu reloads (%llu failed)",
+            s.residentBytes / (1024.0 * 1024.0), s.budget / (1024.0 * 1024.0), s.peakBytes / (1024.0 * 1024.0),
+            s.resident, s.evicted, s.pinned, (unsigned long long)s.evictions,
+            (unsigned long long)s.reloads, (unsigned long long)s.reloadFailures);
+}
@@ -0,0 +1,72 @@
+#include "TileGrid.h"
+#include <algorithm>
+#include <cstring>
+
+TileGrid::TileGrid()
+    : nRows(0)
+    , nCols(0)
+    , capRows(0)
+    , capCols(0)
+{
+}
+
+TileGrid::TileGrid(int rows, int cols)
+    : TileGrid()
+{
+    assign(rows, cols);
+}
+
+void TileGrid::assign(int rows, int cols, Tile v) {
+    rows = std::max(0, rows);
+    cols = std::max(0, cols);
+    if (rows > capRows || cols > capCols) {
+        // fresh buffer sized exactly; geometric growth only kicks in via ensure()
+        cells.assign(static_cast<size_t>(rows) * cols, v);
+        capRows = rows;
+        capCols = cols;
+    } else {
+        std::fill(cells.begin(), cells.end(), TILE_EMPTY);
+        for (int r = 0; r < rows; ++r) std::memset(row(r), v, static_cast<size_t>(cols));
+    }
+    nRows = rows;
+    nCols = cols;
+}
+
+void TileGrid::ensure(int r, int c) {
+    if (r < 0 || c < 0) return;
+    if (r >= capRows || c >= capCols) {
+        int newRows = capRows;
+        int newCols = capCols;
+        if (r >= capRows) newRows = std::max(r + 1, capRows * 2);
+        if (c >= capCols) newCols = std::max(c + 1, capCols * 2);
+        reserve(newRows, newCols);
+    }
+    // cells beyond the old extent are already zero (kept clean by reserve/assign)
+    nRows = std::max(nRows, r + 1);
+    nCols = std::max(nCols, c + 1);
+}
+
+void TileGrid::clear() {
+    cells.clear();
+    nRows = nCols = capRows = capCols = 0;
+}
+
+size_t TileGrid::memoryBytes() const {
+    return cells.capacity() * sizeof(Tile);
+}
+
+void TileGrid::reserve(int rowCap, int colCap) {
+    if (colCap == capCols) {
+        // same stride: rows are appended in place
+        cells.resize(static_cast<size_t>(rowCap) * colCap, TILE_EMPTY);
+        capRows = rowCap;
+        return;
+    }
+    std::vector<Tile> next(static_cast<size_t>(rowCap) * colCap, TILE_EMPTY);
+    for (int r = 0; r < nRows; ++r) {
+        std::memcpy(next.data() + static_cast<size_t>(r) * colCap, row(r), static_cast<size_t>(nCols));
+    }
+    cells.swap(next);
+    capRows = rowCap;
+    capCols = colCap;
+}
@@ -0,0 +1,175 @@
+#include "TileOccupancy.h"
+#include <algorithm>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace {
+int countTrailingZeros(uint64_t v) {
+#ifdef _MSC_VER
+    unsigned long idx = 0;
+    _BitScanForward64(&idx, v);
+    return static_cast<int>(idx);
+#else
+    return __builtin_ctzll(v);
+#endif
+}
+
+// Bits [lo, hi] of a word set (0 <= lo <= hi <= 63)
+uint64_t rangeMask(int lo, int hi) {
+    uint64_t upper = (hi == 63) ? ~0ULL : ((1ULL << (hi + 1)) - 1);
+    return upper & ~((1ULL << lo) - 1);
+}
+}
+
+TileOccupancy::TileOccupancy()
+    : map(nullptr)
+    , listenerId(0)
+    , stale(true)
+    , nRows(0)
+    , nCols(0)
+    , words(0)
+{
+}
+
+TileOccupancy::~TileOccupancy() {
+    detach();
+}
+
+void TileOccupancy::attach(const ChunkedTileMap* m) {
+    detach();
+    map = m;
+    stale = true;
+    if (!map) return;
+    // the listener only reads the map, so adding it through a const map is fine
+    listenerId = const_cast<ChunkedTileMap*>(map)->addChangeListener(
+        [this](int r, int c, TileGrid::Tile oldValue, TileGrid::Tile newValue) { onChange(r, c, oldValue, newValue); });
+}
+
+void TileOccupancy::detach() {
+    if (map && listenerId) const_cast<ChunkedTileMap*>(map)->removeChangeListener(listenerId);
+    map = nullptr;
+    listenerId = 0;
+    stale = true;
+}
+
+void TileOccupancy::onChange(int r, int c, TileGrid::Tile oldValue, TileGrid::Tile newValue) {
+    if (stale) return; // next query rebuilds anyway
+    if (r < 0) {
+        stale = true; // reset
+        return;
+    }
+    if (r >= nRows || c >= nCols) grow(map->rows(), map->cols());
+    size_t i = static_cast<size_t>(r) * words + (c >> 6);
+    uint64_t bit = 1ULL << (c & 63);
+    if (oldValue > TILE_EMPTY && oldValue < TILE_TYPE_COUNT) bits[oldValue][i] &= ~bit;
+    if (newValue > TILE_EMPTY && newValue < TILE_TYPE_COUNT) bits[newValue][i] |= bit;
+}
+
+void TileOccupancy::rebuild() const {
+    stale = false;
+    nRows = map ? map->rows() : 0;
+    nCols = map ? map->cols() : 0;
+    words = (nCols + 63) >> 6;
+    size_t total = static_cast<size_t>(nRows) * words;
+    for (int t = TILE_SOLID; t < TILE_TYPE_COUNT; ++t) bits[t].assign(total, 0);
+    if (total == 0) return;
+
+    // copyRow doesn't page chunks in, so rebuilding never disturbs streaming
+    std::vector<TileGrid::Tile> row(static_cast<size_t>(nCols));
+    for (int r = 0; r < nRows; ++r) {
+        map->copyRow(r, 0, nCols, row.data());
+        size_t base = static_cast<size_t>(r) * words;
+        for (int c = 0; c < nCols; ++c) {
+            TileGrid::Tile t = row[c];
+            if (t > TILE_EMPTY && t < TILE_TYPE_COUNT) bits[t][base + (c >> 6)] |= 1ULL << (c & 63);
+        }
+    }
+}
+
+void TileOccupancy::grow(int rows, int cols) {
+    int need = (cols + 63) >> 6;
+    if (need > words) {
+        // double the row stride, so growing a column at a time re-strides rarely
+        int stride = std::max(need, words * 2);
+        for (int t = TILE_SOLID; t < TILE_TYPE_COUNT; ++t) {
+            std::vector<uint64_t> wider(static_cast<size_t>(nRows) * stride, 0);
+            for (int r = 0; r < nRows; ++r)
+                std::copy_n(bits[t].begin() + static_cast<size_t>(r) * words, words, wider.begin() + static_cast<size_t>(r) * stride);
+            bits[t].swap(wider);
+        }
+        words = stride;
+    }
+    nCols = std::max(nCols, cols);
+    if (rows > nRows) {
+        for (int t = TILE_SOLID; t < TILE_TYPE_COUNT; ++t) bits[t].resize(static_cast<size_t>(rows) * words, 0);
+        nRows = rows;
+    }
+}
+
+bool TileOccupancy::clampBox(int& r0, int& c0, int& r1, int& c1) const {
+    if (stale) rebuild();
+    if (r0 > r1) std::swap(r0, r1);
+    if (c0 > c1) std::swap(c0, c1);
+    r0 = std::max(0, r0);
+    c0 = std::max(0, c0);
+    r1 = std::min(nRows - 1, r1);
+    c1 = std::min(nCols - 1, c1);
+    return r0 <= r1 && c0 <= c1;
+}
+
+bool TileOccupancy::test(uint8_t mask, int r, int c) const {
+    if (stale) rebuild();
+    if (r < 0 || c < 0 || r >= nRows || c >= nCols) return false;
+    return (word(mask, r, c >> 6) >> (c & 63)) & 1ULL;
+}
+
+bool TileOccupancy::any(uint8_t mask, int r0, int c0, int r1, int c1) const {
+    if (!clampBox(r0, c0, r1, c1)) return false;
+    int w0 = c0 >> 6;
+    int w1 = c1 >> 6;
+    for (int r = r0; r <= r1; ++r) {
+        for (int w = w0; w <= w1; ++w) {
+            uint64_t v = word(mask, r, w);
+            if (w == w0 || w == w1) v &= rangeMask(w == w0 ? (c0 & 63) : 0, w == w1 ? (c1 & 63) : 63);
+            if (v) return true;
+        }
+    }
+    return false;
+}
+
+int TileOccupancy::query(uint8_t mask, int r0, int c0, int r1, int c1, std::vector<Span>& out) const {
+    if (!clampBox(r0, c0, r1, c1)) return 0;
+    size_t before = out.size();
+    int w0 = c0 >> 6;
+    int w1 = c1 >> 6;
+    for (int r = r0; r <= r1; ++r) {
+        bool open = false; // a span is running into this word from the previous one
+        for (int w = w0; w <= w1; ++w) {
+            uint64_t v = word(mask, r, w);
+            if (w == w0 || w == w1) v &= rangeMask(w == w0 ? (c0 & 63) : 0, w == w1 ? (c1 & 63) : 63);
+            int base = w << 6;
+            if (open && !(v & 1ULL)) open = false;
+            while (v) {
+                int start = countTrailingZeros(v);
+                uint64_t rest = ~(v >> start);
+                int len = rest ? countTrailingZeros(rest) : 64 - start;
+                if (open && start == 0) {
+                    out.back().c1 = base + len - 1; // continue the span from the previous word
+                } else {
+                    out.push_back(Span{ r, base + start, base + start + len - 1 });
+                }
+                open = (start + len == 64);
+                v = (start + len == 64) ? 0 : (v & ~rangeMask(0, start + len - 1));
+            }
+        }
+    }
+    return static_cast<int>(out.size() - before);
+}
+
+size_t TileOccupancy::memoryBytes() const {
+    size_t total = 0;
+    for (int t = TILE_SOLID; t < TILE_TYPE_COUNT; ++t) total += bits[t].capacity() * sizeof(uint64_t);
+    return total;
+}
@@ -0,0 +1,221 @@
+#include "TileRenderer.h"
+#include "Level.h"
+#include <algorithm>
+
+namespace {
+// fill colour per tile type; the last entry is used for unknown ids
+const SDL_Color kTileColors[TILE_TYPE_COUNT + 1] = {
+    {0, 0, 0, 0},         // empty (never drawn)
+    {128, 128, 128, 255}, // solid
+    {160, 40, 40, 255},   // damaging
+    {200, 200, 60, 255},  // pickup
+    {100, 100, 100, 255}, // other
+};
+
+// baked chunks kept around on each side of the visible ones
+const int kKeepChunks = 2;
+}
+
+TileRenderer::TileRenderer()
+    : drawCalls(0)
+    , tileCount(0)
+    , bakes(0)
+    , baking(true)
+    , chunkW(0)
+    , chunkH(0)
+    , bakedCellW(0)
+    , bakedCellH(0)
+    , attached(nullptr)
+    , listenerId(0)
+{
+}
+
+TileRenderer::~TileRenderer() {
+    detach();
+    destroyChunks();
+}
+
+void TileRenderer::attach(Level* level) {
+    detach();
+    attached = level;
+    if (!attached) return;
+    listenerId = attached->grid.addChangeListener([this](int r, int c, TileGrid::Tile, TileGrid::Tile) {
+        if (r < 0 || c < 0) invalidateAll();
+        else invalidateCell(r, c);
+    });
+    invalidateAll();
+}
+
+void TileRenderer::detach() {
+    if (attached && listenerId) attached->grid.removeChangeListener(listenerId);
+    attached = nullptr;
+    listenerId = 0;
+}
+
+void TileRenderer::render(SDL_Renderer* ren, const Level& level, int camX, int viewW, int viewH, int cellW, int cellH) {
+    drawCalls = 0;
+    tileCount = 0;
+    bakes = 0;
+    if (!ren || cellW <= 0 || cellH <= 0 || viewW <= 0 || viewH <= 0) return;
+    if (level.rows() <= 0 || level.cols() <= 0) return;
+
+    if (baking && SDL_RenderTargetSupported(ren)) {
+        renderBaked(ren, level, camX, viewW, viewH, cellW, cellH);
+    } else {
+        renderDirect(ren, level, camX, viewW, viewH, cellW, cellH);
+    }
+}
+
+void TileRenderer::invalidateAll() {
+    for (auto& ch : chunks) ch.dirty = true;
+}
+
+void TileRenderer::invalidateCell(int r, int c) {
+    if (r < 0 || c < 0 || chunkW <= 0 || bakedCellW <= 0) return;
+    size_t index = static_cast<size_t>((c * bakedCellW) / chunkW);
+    if (index < chunks.size()) chunks[index].dirty = true;
+    // a tile straddling the chunk edge shows up in the next chunk as well
+    size_t right = static_cast<size_t>(((c + 1) * bakedCellW - 1) / chunkW);
+    if (right != index && right < chunks.size()) chunks[right].dirty = true;
+}
+
+void TileRenderer::setBaking(bool enabled) {
+    baking = enabled;
+    if (!baking) destroyChunks();
+}
+
+int TileRenderer::lastDrawCalls() const {
+    return drawCalls;
+}
+
+int TileRenderer::lastTileCount() const {
+    return tileCount;
+}
+
+int TileRenderer::lastBakes() const {
+    return bakes;
+}
+
+void TileRenderer::collect(const Level& level, int firstCol, int lastCol, int lastRow, int originX, int cellW, int cellH) {
+    for (auto& b : batches) b.clear();
+    firstCol = std::max(0, firstCol);
+    lastCol = std::min(level.cols() - 1, lastCol);
+    lastRow = std::min(level.rows() - 1, lastRow);
+    if (firstCol > lastCol || lastRow < 0) return;
+
+    int span = lastCol - firstCol + 1;
+    rowBuf.resize(static_cast<size_t>(span));
+    for (int r = 0; r <= lastRow; ++r) {
+        level.grid.copyRow(r, firstCol, span, rowBuf.data());
+        int y = r * cellH;
+        for (int i = 0; i < span; ++i) {
+            int cell = rowBuf[i];
+            if (cell == TILE_EMPTY) continue;
+            int bucket = (cell < TILE_TYPE_COUNT) ? cell : TILE_TYPE_COUNT;
+            batches[bucket].push_back(SDL_Rect{ (firstCol + i) * cellW - originX, y, cellW, cellH });
+        }
+    }
+}
+
+void TileRenderer::submit(SDL_Renderer* ren) {
+    for (int b = 1; b < kBuckets; ++b) {
+        if (batches[b].empty()) continue;
+        const SDL_Color& col = kTileColors[b];
+        SDL_SetRenderDrawColor(ren, col.r, col.g, col.b, col.a);
+        SDL_RenderFillRects(ren, batches[b].data(), static_cast<int>(batches[b].size()));
+        ++drawCalls;
+        tileCount += static_cast<int>(batches[b].size());
+    }
+}
+
+void TileRenderer::renderDirect(SDL_Renderer* ren, const Level& level, int camX, int viewW, int viewH, int cellW, int cellH) {
+    // Visible cell range
+    int firstCol = std::max(0, camX / cellW);
+    int lastCol = (camX + viewW - 1) / cellW;
+    int lastRow = (viewH - 1) / cellH;
+    collect(level, firstCol, lastCol, lastRow, camX, cellW, cellH);
+    submit(ren);
+}
+
+void TileRenderer::renderBaked(SDL_Renderer* ren, const Level& level, int camX, int viewW, int viewH, int cellW, int cellH) {
+    // chunk geometry follows the view; any change re-bakes everything
+    if (viewW != chunkW || viewH != chunkH || cellW != bakedCellW || cellH != bakedCellH) {
+        destroyChunks();
+        chunkW = viewW;
+        chunkH = viewH;
+        bakedCellW = cellW;
+        bakedCellH = cellH;
+    }
+
+    int levelW = level.cols() * cellW;
+    size_t needed = static_cast<size_t>((levelW + chunkW - 1) / chunkW);
+    if (chunks.size() < needed) chunks.resize(needed);
+
+    int first = std::max(0, camX / chunkW);
+    int last = std::min(static_cast<int>(needed) - 1, (camX + viewW - 1) / chunkW);
+    int lastRow = (viewH - 1) / cellH;
+
+    // free baked chunks that scrolled far away to keep VRAM flat
+    for (int i = 0; i < static_cast<int>(chunks.size()); ++i) {
+        if ((i < first - kKeepChunks || i > last + kKeepChunks) && chunks[i].tex) {
+            SDL_DestroyTexture(chunks[i].tex);
+            chunks[i].tex = nullptr;
+            chunks[i].dirty = true;
+        }
+    }
+
+    for (int i = first; i <= last; ++i) {
+        BakedChunk& ch = chunks[i];
+        if ((!ch.tex || ch.dirty) && !bake(ren, level, i, lastRow)) {
+            // render target trouble: draw this frame directly instead
+            renderDirect(ren, level, camX, viewW, viewH, cellW, cellH);
+            return;
+        }
+        SDL_Rect dst{ i * chunkW - camX, 0, chunkW, chunkH };
+        SDL_RenderCopy(ren, ch.tex, nullptr, &dst);
+        ++drawCalls;
+    }
+}
+
+bool TileRenderer::bake(SDL_Renderer* ren, const Level& level, int index, int lastRow) {
+    BakedChunk& ch = chunks[index];
+    if (!ch.tex) {
+        ch.tex = SDL_CreateTexture(ren, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, chunkW, chunkH);
+        if (!ch.tex) {
+            SDL_Log("TileRenderer: SDL_CreateTexture failed: %s", SDL_GetError());
+            baking = false;
+            return false;
+        }
+        SDL_SetTextureBlendMode(ch.tex, SDL_BLENDMODE_BLEND);
+    }
+
+    SDL_Texture* prevTarget = SDL_GetRenderTarget(ren);
+    if (SDL_SetRenderTarget(ren, ch.tex) != 0) {
+        SDL_Log("TileRenderer: SDL_SetRenderTarget failed: %s", SDL_GetError());
+        baking = false;
+        return false;
+    }
+
+    SDL_SetRenderDrawColor(ren, 0, 0, 0, 0);
+    SDL_RenderClear(ren);
+
+    int originX = index * chunkW;
+    int firstCol = originX / bakedCellW;
+    int lastCol = (originX + chunkW - 1) / bakedCellW;
+    collect(level, firstCol, lastCol, lastRow, originX, bakedCellW, bakedCellH);
+    int calls = drawCalls;
+    submit(ren);
+    drawCalls = calls; // bake submissions aren't per-frame draw calls
+
+    SDL_SetRenderTarget(ren, prevTarget);
+    ch.dirty = false;
+    ++bakes;
+    return true;
+}
+
+void TileRenderer::destroyChunks() {
+    for (auto& ch : chunks) {
+        if (ch.tex) SDL_DestroyTexture(ch.tex);
+    }
+    chunks.clear();
+}
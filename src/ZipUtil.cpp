@@ -1,26 +1,72 @@
 #include "ZipUtil.h"
 extern "C" {
 #include "zip.h" // minizip
+#include "unzip.h"
 }
-#include <cstring>
 
-bool saveLevelZip(const std::string& zipPath, const std::string& layout, const std::string& assets){
-    zipFile zf = zipOpen(zipPath.c_str(), 0);
+bool writeZip(const std::string& zipPath, const std::vector<ZipEntry>& entries){
+    zipFile zf = zipOpen(zipPath.c_str(), APPEND_STATUS_CREATE);
     if(!zf) return false;
 
+    bool ok = true;
     zip_fileinfo zi{};
-    if(zipOpenNewFileInZip(zf, "layout.txt", &zi, nullptr,0,nullptr,0,nullptr, Z_DEFLATED, Z_DEFAULT_COMPRESSION) != ZIP_OK){
-        zipClose(zf, nullptr); return false;
+    for(const ZipEntry& e : entries){
+        if(zipOpenNewFileInZip(zf, e.name.c_str(), &zi, nullptr,0,nullptr,0,nullptr, Z_DEFLATED, Z_DEFAULT_COMPRESSION) != ZIP_OK){
+            ok = false;
+            break;
+        }
+        // minizip takes unsigned lengths; write big entries in pieces
+        const char* p = static_cast<const char*>(e.data);
+        size_t left = e.size;
+        while(ok && left > 0){
+            unsigned n = static_cast<unsigned>(left > (1u << 30) ? (1u << 30) : left);
+            if(zipWriteInFileInZip(zf, p, n) != ZIP_OK) ok = false;
+            p += n;
+            left -= n;
+        }
+        if(zipCloseFileInZip(zf) != ZIP_OK) ok = false;
+        if(!ok) break;
+    }
+
+    if(zipClose(zf, nullptr) != ZIP_OK) ok = false;
+    return ok;
+}
+
+bool readZipEntry(const std::string& zipPath, const std::string& name, std::vector<uint8_t>& out, size_t maxSize){
+    unzFile uf = unzOpen(zipPath.c_str());
+    if(!uf) return false;
+    if(unzLocateFile(uf, name.c_str(), 0) != UNZ_OK){
+        unzClose(uf); return false;
+    }
+    unz_file_info info{};
+    if(unzGetCurrentFileInfo(uf, &info, nullptr,0,nullptr,0,nullptr,0) != UNZ_OK || unzOpenCurrentFile(uf) != UNZ_OK){
+        unzClose(uf); return false;
+    }
+    // the size comes from the archive, so don't trust it with an allocation
+    if(info.uncompressed_size > maxSize){
+        unzCloseCurrentFile(uf);
+        unzClose(uf); return false;
     }
-    zipWriteInFileInZip(zf, layout.data(), (unsigned)layout.size());
-    zipCloseFileInZip(zf);
 
-    if(zipOpenNewFileInZip(zf, "assets.txt", &zi, nullptr,0,nullptr,0,nullptr, Z_DEFLATED, Z_DEFAULT_COMPRESSION) != ZIP_OK){
-        zipClose(zf, nullptr); return false;
+    out.resize(static_cast<size_t>(info.uncompressed_size));
+    size_t got = 0;
+    bool ok = true;
+    while(got < out.size()){
+        unsigned want = static_cast<unsigned>((out.size() - got) > (1u << 30) ? (1u << 30) : (out.size() - got));
+        int n = unzReadCurrentFile(uf, out.data() + got, want);
+        if(n <= 0){ ok = false; break; }
+        got += static_cast<size_t>(n);
     }
-    zipWriteInFileInZip(zf, assets.data(), (unsigned)assets.size());
-    zipCloseFileInZip(zf);
+    // closing checks the CRC once the whole entry has been read
+    if(unzCloseCurrentFile(uf) != UNZ_OK) ok = false;
+    unzClose(uf);
+    if(!ok) out.clear();
+    return ok;
+}
 
-    zipClose(zf, nullptr);
-    return true;
-}
\ No newline at end of file
+bool saveLevelZip(const std::string& zipPath, const std::string& layout, const std::string& assets){
+    return writeZip(zipPath, {
+        { "layout.txt", layout.data(), layout.size() },
+        { "assets.txt", assets.data(), assets.size() },
+    });
+}
@@ -5,103 +5,48 @@
 #include "Texture.h"
 #include "Player.h"
 #include "Level.h"
+#include "Background.h"
+#include "TileRenderer.h"
+#include "Simulation.h"
+#include "ActorRender.h"
 #include "LevelEditor.h"
 #include "Menu.h"
 #include "MainMenu.h"
+#include "TextRenderer.h"
+#include "AssetCache.h"
+#include "SpriteAtlas.h"
+#include "AssetArchive.h"
+#include "LevelSaver.h"
+#include "InputRecording.h"
+#include "FramePacer.h"
+#include "TextureResidency.h"
+#include <memory>
+#include "FixedTimestep.h"
+#include "FrameProfiler.h"
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <string>
+#include <vector>
 
-
-static void resolvePlayerCollisions(Player& player, Level& level, int cellW, int cellH) {
-    if (cellW <= 0 || cellH <= 0) return;
-    if (level.rows <= 0 || level.cols <= 0) return;
-
-    const float eps = 0.0001f;
-
-    // Physics: player.x is left, player.y is _feet_ (bottom).
-    float px = player.x;
-    float pw = static_cast<float>(player.width);
-    float top = player.y - static_cast<float>(player.height);
-    float ph = static_cast<float>(player.height);
-
-    int minCol = (int)std::floor(px / cellW);
-    int maxCol = (int)std::floor((px + pw - eps) / cellW);
-    int minRow = (int)std::floor(top / cellH);
-    int maxRow = (int)std::floor((top + ph - eps) / cellH);
-
-    minCol = std::max(0, minCol);
-    minRow = std::max(0, minRow);
-    maxCol = std::min(level.cols - 1, maxCol);
-    maxRow = std::min(level.rows - 1, maxRow);
-
-    for (int r = minRow; r <= maxRow; ++r) {
-        if (r < 0 || r >= (int)level.grid.size()) continue;
-        for (int c = minCol; c <= maxCol; ++c) {
-            if (c < 0 || c >= (int)level.grid[r].size()) continue;
-
-            int cell = level.grid[r][c]; // 0=empty,1=solid,2=damaging,3=pickup
-            if (cell == 0) continue; // non-solid
-
-            float tx = static_cast<float>(c * cellW);
-            float ty = static_cast<float>(r * cellH);
-
-            float ix = std::min(px + pw, tx + cellW) - std::max(px, tx);
-            float iy = std::min(top + ph, ty + cellH) - std::max(top, ty);
-
-            if (ix > 0.0f && iy > 0.0f) {
-                if (cell == 3) {
-                    player.score += 10;
-                    level.grid[r][c] = 0; // remove pickup
-                    continue;
-                }
-
-                bool isDamaging = (cell == 2);
-
-                // Resolve along smaller penetration (push player out)
-                if (ix < iy) {
-                    // horizontal push
-                    if (px + pw * 0.5f < tx + cellW * 0.5f) {
-                        // push left
-                        px -= ix;
-                    } else {
-                        // push right
-                        px += ix;
-                    }
-                    // apply immediate horizontal correction
-                    player.x = px;
-                } else {
-                    // vertical push
-                    if (top + ph * 0.5f < ty + cellH * 0.5f) {
-                        // collision from above -> place player on top of tile
-                        top = ty - ph;
-                        player.vy = 0.0f;
-                        player.onGround = true;
-                    } else {
-                        // collision from below -> push player down (head hit)
-                        top += iy;
-                        if (player.vy < 0.0f) player.vy = 0.0f;
-                    }
-                    // apply immediate vertical correction
-                    player.y = top + ph;
-                }
-
-                // Handle damage
-                if (isDamaging && player.invulnTimer <= 0.0f) {
-                    player.health -= 1;
-                    player.invulnTimer = player.invuln;
-                    if (player.health < 0) player.health = 0;
-                }
-            }
-        }
+int main(int argc, char* argv[]) {
+    // --record <file>: capture each level run for projekcik_replay
+    // --fps <n>: cap the frame rate (0 = uncapped, paced by vsync only)
+    // --no-vsync: present immediately; use with --fps for 144/240 Hz pacing
+    // --texture-budget <MB>: GPU texture memory before LRU eviction (0 = unlimited)
+    std::string recordPath;
+    double targetFps = 0.0;
+    bool vsync = true;
+    double textureBudgetMb = 64.0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--record" && i + 1 < argc) recordPath = argv[++i];
+        else if (arg == "--fps" && i + 1 < argc) targetFps = std::atof(argv[++i]);
+        else if (arg == "--no-vsync") vsync = false;
+        else if (arg == "--texture-budget" && i + 1 < argc) textureBudgetMb = std::atof(argv[++i]);
     }
 
-    // Ensure the resolved values are applied
-    player.x = px;
-    player.y = top + ph;
-}
-
-int main(int argc, char* argv[]) {
     if(SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER) != 0){
         std::cerr << "SDL_Init Error: " << SDL_GetError() << "\n";
         return 1;
@@ -122,7 +67,7 @@ int main(int argc, char* argv[]) {
     const int WINH = 288, WINW = 512;
     SDL_Window* win = SDL_CreateWindow("Projekcik", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, WINW, WINH, SDL_WINDOW_FULLSCREEN_DESKTOP | SDL_WINDOW_SHOWN);
     if(!win){ std::cerr << "CreateWindow failed\n"; IMG_Quit(); SDL_Quit(); return 1; }
-    SDL_Renderer* ren = SDL_CreateRenderer(win, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    SDL_Renderer* ren = SDL_CreateRenderer(win, -1, SDL_RENDERER_ACCELERATED | (vsync ? SDL_RENDERER_PRESENTVSYNC : 0));
     if(!ren){ std::cerr << "CreateRenderer failed\n"; SDL_DestroyWindow(win); IMG_Quit(); SDL_Quit(); return 1; }
 
     // keep logical game coords at WINW x WINH even in fullscreen
@@ -130,42 +75,91 @@ int main(int argc, char* argv[]) {
 
     // asset path setup
     char* basePath = SDL_GetBasePath();
-    std::string assetsDir;
+    std::string baseDir;
     if (basePath) {
-        assetsDir = std::string(basePath) + "assets/";
+        baseDir = basePath;
         SDL_free(basePath);
-    } else {
-        assetsDir = "assets/";
     }
+    std::string assetsDir = baseDir + "assets/";
 
-    TTF_Font* hudFont = nullptr;
+    // one mapped archive instead of per-file opens; loose files remain the fallback
+    if (!AssetArchive::mount(baseDir + "assets.pak", assetsDir)) {
+        SDL_Log("DBG: assets.pak not found, loading loose files from %s", assetsDir.c_str());
+    }
+
+    // HUD text: glyph atlas + cached string textures
     std::string hudFontPath = (assetsDir + "DejaVuSans.ttf");
-    hudFont = TTF_OpenFont(hudFontPath.c_str(), 24); // larger for game over screens
-    if(!hudFont){
+    TextRenderer* hudText = new TextRenderer(ren, hudFontPath, 24); // larger for game over screens
+    if(!hudText->ok()){
         SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "HUD font not opened: %s", TTF_GetError());
-        hudFont = nullptr;
     }
+    // In-game menu labels keep their 18pt size; they're cached textures, so no atlas
+    TextRenderer* menuText = new TextRenderer(ren, hudFontPath, 18, false);
+    const SDL_Color hudColor = {0, 0, 0, 255};
+    const std::string editorHint = "Edytor: strza\u0142ki - ruch, Tab - narz\u0119dzie, 0-3 - klocek, Ctrl+Z/Y - cofnij/pon\u00F3w, Ctrl+C/V - kopiuj/wklej";
+    CachedText lostText(hudText, SDL_Color{255, 0, 0, 255});
+    lostText.set("Przegra\u0142e\u015B");
+    CachedText wonText(hudText, SDL_Color{255, 215, 0, 255});
+    wonText.set("Wygra\u0142e\u015B");
+
+    // Textures shared across menu/level transitions, under one memory budget
+    TextureResidency textureBudget(static_cast<size_t>(std::max(0.0, textureBudgetMb) * 1024.0 * 1024.0));
+    AssetCache assets(ren, &textureBudget);
+
+    // Level backgrounds are drawn WINH logical rows tall, i.e. this many
+    // output pixels; they're resampled to that once at load instead of being
+    // shrunk by the GPU every frame. Mips are kept only down to WINH rows,
+    // the smallest height they are ever drawn at.
+    auto backgroundDisplayHeight = [&]() {
+        int outW = 0, outH = 0;
+        SDL_GetRendererOutputSize(ren, &outW, &outH);
+        float scale = std::min((float)outW / (float)WINW, (float)outH / (float)WINH);
+        return std::max(WINH, (int)std::ceil(WINH * scale));
+    };
+    auto fitBackgrounds = [&]() {
+        TextureFit bgFit;
+        bgFit.maxHeight = backgroundDisplayHeight();
+        bgFit.mipLevels = 3;
+        bgFit.minMipHeight = WINH;
+        for (int lvl = 0; lvl <= 9; ++lvl) assets.setFit(MainMenu::levelBackground(assetsDir, lvl), bgFit);
+    };
+    fitBackgrounds();
+
+    // F3: frame profiler overlay, F4: dump its history to CSV
+    FrameProfiler profiler(240);
+    // frame pacing: gameplay at the requested rate, static screens at 60 fps
+    FramePacer gamePacer(targetFps);
+    FramePacer screenPacer(60.0);
+    TextRenderer* debugText = new TextRenderer(ren, hudFontPath, 10);
+
+    // Level saves run on a worker; completion shows up as a short HUD toast
+    LevelSaver levelSaver;
+    InputRecorder recorder;
+    CachedText toastText(hudText, hudColor);
+    float toastTimer = 0.0f;
+
+    // Player walk cycle packed into one atlas page: one texture, no per-frame queries
+    SpriteAtlas* playerAtlas = new SpriteAtlas();
+    const int walk1 = playerAtlas->add(assetsDir + "chodzenie_1.png");
+    const int walk2 = playerAtlas->add(assetsDir + "chodzenie_2.png");
+    const int walk3 = playerAtlas->add(assetsDir + "chodzenie_3.png");
+    playerAtlas->build(ren);
 
     // Main game loop
     while (true) {
         // Show main menu
-        MainMenu mainMenu(ren, assetsDir);
+        MainMenu mainMenu(ren, assets, assetsDir);
         int selectedLevel = mainMenu.run();
         if (selectedLevel == -1) break; // kill
 
-        std::string bgFile = "poziom_" + std::to_string(selectedLevel) + "_tlo.jpg";
-
-        // Load assets using assetsDir
-        Texture bgTex;
-        bgTex.load(ren, (assetsDir + bgFile).c_str());
+        // Load assets using assetsDir (background usually prefetched by the menu)
+        std::string bgPath = MainMenu::levelBackground(assetsDir, selectedLevel);
+        std::shared_ptr<Texture> bgTex = assets.texture(bgPath);
 
-        Texture f1,f2,f3;
-        f1.load(ren, (assetsDir + "chodzenie_1.png").c_str());
-        f2.load(ren, (assetsDir + "chodzenie_2.png").c_str());
-        f3.load(ren, (assetsDir + "chodzenie_3.png").c_str());
+        assets.logStats();
 
         // Abort gracefully if required textures are missing
-        if (!bgTex.tex || !f1.tex || !f2.tex || !f3.tex) {
+        if (!bgTex || !playerAtlas->complete()) {
             SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Missing assets",
                                      "One or more assets failed to load. Ensure the `assets` folder is next to the executable or adjust the working directory.",
                                      win);
@@ -174,35 +168,42 @@ int main(int argc, char* argv[]) {
 
         // Use logical WINW/WINH for level/frame sizing and rendering math
         Level level;
-        level.setFrameSize(WINW, WINH);
-        level.cols = 156; // map size
-        level.grid.assign(level.rows, std::vector<int>(level.cols, 0));
+        Background background;
+        TileRenderer tileRenderer;
+        background.setFrameSize(WINW, WINH);
+        level.grid.assign(level.rows(), 156); // map size
         SDL_Log("DBG: level frame size set to %dx%d", WINW, WINH);
-        int groundRow = level.rows - 2;
+        int groundRow = level.rows() - 2;
         if (groundRow >= 0) {
-            for (int c = 0; c < level.cols; ++c) {
-                level.grid[groundRow][c] = 1; // solid ground
+            for (int c = 0; c < level.cols(); ++c) {
+                level.grid.set(groundRow, c, TILE_SOLID); // solid ground
             }
         }
 
-        level.setBackgroundTexture(bgTex.tex);
-        level.setBackgroundRepeat(false); // scroll once
-        level.setScrollSpeed(0.0f); // no auto-scroll
-        level.setParallax(0.25f); // parallax
-        level.setBackgroundMaxSpeed(50.0f); // max 50 px/sec
+        // baked tile layer re-bakes chunks when tiles change
+        tileRenderer.attach(&level);
+
+        bgTex->selectLevel(backgroundDisplayHeight());
+        background.setTexture(bgTex->tex);
+        background.setRepeat(false); // scroll once
+        background.setScrollSpeed(0.0f); // no auto-scroll
+        background.setParallax(0.25f); // parallax
+        background.setMaxSpeed(50.0f); // max 50 px/sec
 
         Player player;
-        player.frames = { &f3, &f2, &f3, &f1 };
+        player.frames = { playerAtlas->frame(walk3), playerAtlas->frame(walk2),
+                          playerAtlas->frame(walk3), playerAtlas->frame(walk1) };
         player.width = 32; player.height = 48;
         player.x = 10.f;
 
         // Place player on ground initially
-        int levelH = level.rows * 32; // base tile = 32
+        int levelH = level.rows() * 32; // base tile = 32
         player.y = static_cast<float>(std::max(0, levelH - player.height)); // put player on bottom of level
         player.onGround = true;
         player.vy = 0.0f;
+        player.storePrevious();
 
-        level.backgroundPath = assetsDir + bgFile;
+        level.backgroundPath = bgPath;
         level.usedAssets = { assetsDir + "chodzenie_1.png", assetsDir + "chodzenie_2.png", assetsDir + "chodzenie_3.png" };
 
         const float editorTileScale = 1.0f;   // used only by LevelEditor
@@ -211,49 +212,161 @@ int main(int argc, char* argv[]) {
 
         // create editor
         LevelEditor* editor = new LevelEditor(&level, WINW, WINH, editorTileScale, baseTilePixels);
+        // every editor write goes into the recording, undo/redo included
+        editor->setCellSink([&](int r, int c, TileGrid::Tile v) { recorder.edit(r, c, v); });
         float camX = 0.0f;
         float editorCamX = 0.0f;
 
+        // Editor tools, switched with Tab: click (cycle a cell), line, rect,
+        // flood and select. Keys 0-3 pick the tile that line/rect/flood paint.
+        enum EditTool { TOOL_CYCLE, TOOL_LINE, TOOL_RECT, TOOL_FLOOD, TOOL_SELECT, TOOL_COUNT };
+        const char* const editToolNames[TOOL_COUNT] = {
+            "klik", "linia", "prostok\u0105t", "wype\u0142nianie", "zaznaczenie" };
+        int editTool = TOOL_CYCLE;
+        TileGrid::Tile paintTile = TILE_SOLID;
+        bool dragging = false; // rect/select drag in progress
+        int dragRow0 = 0, dragCol0 = 0, dragRow1 = 0, dragCol1 = 0;
+        bool hasSelection = false;
+        int selRow0 = 0, selCol0 = 0, selRow1 = 0, selCol1 = 0;
+        CachedText editorToolText(hudText, hudColor);
+
+        // Cell under the mouse in editor space
+        auto editorMouseCell = [&](int* row, int* col) -> bool {
+            int winMouseX_state = 0, winMouseY_state = 0;
+            SDL_GetMouseState(&winMouseX_state, &winMouseY_state);
+
+            // Window size in window coordinates
+            int winW_win = 0, winH_win = 0;
+            SDL_GetWindowSize(win, &winW_win, &winH_win);
+            if (winW_win <= 0 || winH_win <= 0) return false;
+
+            // Renderer output size in pixels
+            int outW_pixels = 0, outH_pixels = 0;
+            SDL_GetRendererOutputSize(ren, &outW_pixels, &outH_pixels);
+            if (outW_pixels <= 0 || outH_pixels <= 0) return false;
+
+            // Logical size
+            int logicalW = 0, logicalH = 0;
+            SDL_RenderGetLogicalSize(ren, &logicalW, &logicalH);
+            if (logicalW <= 0 || logicalH <= 0) return false;
+
+            float lx = static_cast<float>(winMouseX_state) * static_cast<float>(logicalW) / static_cast<float>(winW_win);
+            float ly = static_cast<float>(winMouseY_state) * static_cast<float>(logicalH) / static_cast<float>(winH_win);
+
+            float editorScale = 1.0f / editorTileScale;
+            float mx_editor = lx * editorScale;
+            float my_editor = ly * editorScale;
+
+            // Compute floating camera offset in editor pixel-space (avoid rounding)
+            float camX_editor_f = camX * editorScale;
+
+            // Pass float logical coordinates to editor for precise mapping
+            return editor->cellAt(mx_editor, my_editor, camX_editor_f, row, col);
+        };
+
         // Menu setup
-        Menu menu(ren, (assetsDir + "DejaVuSans.ttf").c_str(), 18);
+        Menu menu(ren, menuText);
+        menu.setResidency(&textureBudget);
         menu.addItem("Reload textures", [&](){
-            f1.load(ren, (assetsDir + "chodzenie_1.png").c_str());
-            f2.load(ren, (assetsDir + "chodzenie_2.png").c_str());
-            f3.load(ren, (assetsDir + "chodzenie_3.png").c_str());
-            bgTex.load(ren, (assetsDir + "poziom_0_tlo.jpg").c_str());
-            level.setBackgroundTexture(bgTex.tex);
-            level.setBackgroundRepeat(false);
-            level.setScrollSpeed(0.0f);
-            level.setParallax(0.25f);
-            level.setBackgroundMaxSpeed(50.0f);
+            // re-pack the atlas; old pages are gone, so refresh the frame regions too
+            playerAtlas->build(ren);
+            player.frames = { playerAtlas->frame(walk3), playerAtlas->frame(walk2),
+                              playerAtlas->frame(walk3), playerAtlas->frame(walk1) };
+            std::shared_ptr<Texture> reloadedBg = assets.reload(assetsDir + "poziom_0_tlo.jpg");
+            if (reloadedBg) bgTex = reloadedBg;
+            background.setTexture(bgTex->tex);
+            background.setRepeat(false);
+            background.setScrollSpeed(0.0f);
+            background.setParallax(0.25f);
+            background.setMaxSpeed(50.0f);
             SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_INFORMATION, "Menu", "Textures reloaded", win);
     });
         menu.addItem("Save level", [&](){
-            level.saveToZip("level_saved.zip");
-            SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_INFORMATION, "Menu", "Level saved", win);
+            levelSaver.save(level, "level_saved.zip");
+        });
+
+        // Load the saved level in place (tile renderer re-bakes via the grid's reset notification)
+        auto loadSavedLevel = [&]() -> bool {
+            // a save still queued or being written would be read half-done or stale
+            levelSaver.flush();
+            std::string err;
+            if (!level.loadFromZip("level_saved.zip", &err)) {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Level load failed: %s", err.c_str());
+                return false;
+            }
+            // undo steps refer to the old grid
+            editor->clearHistory();
+            dragging = false;
+            hasSelection = false;
+            if (recorder.active()) {
+                // the recording's start level no longer matches what's being played
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Level replaced, recording discarded");
+                recorder.cancel();
+            }
+            if (!level.backgroundPath.empty() && level.backgroundPath != bgPath) {
+                std::shared_ptr<Texture> loadedBg = assets.texture(level.backgroundPath);
+                if (loadedBg) {
+                    bgTex = loadedBg;
+                    bgPath = level.backgroundPath;
+                    background.setTexture(bgTex->tex);
+                }
+            }
+            SDL_Log("DBG: level loaded: %dx%d", level.rows(), level.cols());
+            return true;
+        };
+        menu.addItem("Load level", [&](){
+            bool ok = loadSavedLevel();
+            SDL_ShowSimpleMessageBox(ok ? SDL_MESSAGEBOX_INFORMATION : SDL_MESSAGEBOX_ERROR, "Menu",
+                                     ok ? "Level loaded" : "Level could not be loaded", win);
         });
 
+        // HUD values are re-rendered only when they change
+        CachedText scoreText(hudText, hudColor);
+        CachedText healthText(hudText, hudColor);
+        int shownScore = -1;
+        int shownHealth = -1;
+
         bool running = true;
         bool editMode = false;
         bool playerLost = false;
         bool playerWon = false;
         float fade = 0.0f;
+
+        // Physics runs at a fixed tick rate independent of the display rate;
+        // the renderer interpolates between the last two ticks.
+        const double simTickRate = 120.0;
+        const int simMaxCatchUpSteps = 8;
+        FixedTimestep simClock(simTickRate, simMaxCatchUpSteps);
+        Simulation sim(level, player, baseTilePixels);
+        sim.setProfiler(&profiler);
+        if (!recordPath.empty()) recorder.begin(level, player, simClock.tickDt(), baseTilePixels);
         Uint64 last = SDL_GetPerformanceCounter();
+        gamePacer.resync(); // level setup isn't a frame to catch up on
 
         // Game loop
         while(running) {
             Uint64 now = SDL_GetPerformanceCounter();
             double dt = (double)(now - last) / (double)SDL_GetPerformanceFrequency();
             last = now;
+            profiler.beginFrame();
 
             SDL_Event ev;
+            Uint64 eventsStart = SDL_GetPerformanceCounter();
             while (SDL_PollEvent(&ev)) {
                 if (ev.type == SDL_QUIT) { running = false; break; }
 
                 if (ev.type == SDL_WINDOWEVENT && ev.window.event == SDL_WINDOWEVENT_RESIZED) {
-                    // Recreate editor on window size change
-                    delete editor;
-                    editor = new LevelEditor(&level, WINW, WINH, editorTileScale, baseTilePixels);
+                    // keep the editor (and its undo history), just tell it the new size
+                    editor->setWindowSize(WINW, WINH);
+                    // background: nearest mip for the new output size; later loads fit it exactly
+                    if (bgTex->selectLevel(backgroundDisplayHeight())) background.setTexture(bgTex->tex);
+                    fitBackgrounds();
+                    continue;
+                }
+
+                if (ev.type == SDL_RENDER_TARGETS_RESET || ev.type == SDL_RENDER_DEVICE_RESET) {
+                    // render-target contents are lost; re-bake tile chunks
+                    tileRenderer.invalidateAll();
                     continue;
                 }
 
@@ -268,9 +381,26 @@ int main(int argc, char* argv[]) {
                 }
 
                 if (ev.type == SDL_KEYDOWN) {
-                    if (ev.key.keysym.scancode == SDL_SCANCODE_E) { editMode = !editMode; if (editMode) editorCamX = camX; continue; }
+                    if (ev.key.keysym.scancode == SDL_SCANCODE_E) {
+                        editMode = !editMode;
+                        if (editMode) editorCamX = camX;
+                        else { editor->endStroke(); dragging = false; }
+                        continue;
+                    }
                     if (ev.key.keysym.scancode == SDL_SCANCODE_S && (SDL_GetModState() & KMOD_CTRL)) {
-                        level.saveToZip("level_saved.zip");
+                        levelSaver.save(level, "level_saved.zip");
+                        continue;
+                    }
+                    if (ev.key.keysym.scancode == SDL_SCANCODE_L && (SDL_GetModState() & KMOD_CTRL)) {
+                        loadSavedLevel();
+                        continue;
+                    }
+                    if (ev.key.keysym.scancode == SDL_SCANCODE_F3) {
+                        profiler.setOverlayVisible(!profiler.overlayVisible());
+                        continue;
+                    }
+                    if (ev.key.keysym.scancode == SDL_SCANCODE_F4) {
+                        profiler.dumpCsv("frame_profile.csv");
                         continue;
                     }
                     if (ev.key.keysym.scancode == SDL_SCANCODE_F11) {
@@ -285,58 +415,91 @@ int main(int argc, char* argv[]) {
                 }
 
                 if (editMode && ev.type == SDL_KEYDOWN) {
+                    SDL_Scancode sc = ev.key.keysym.scancode;
+                    SDL_Keymod mod = SDL_GetModState();
+                    if ((mod & KMOD_CTRL) && sc == SDL_SCANCODE_Z) {
+                        if (mod & KMOD_SHIFT) editor->redo();
+                        else editor->undo();
+                        continue;
+                    }
+                    if ((mod & KMOD_CTRL) && sc == SDL_SCANCODE_Y) { editor->redo(); continue; }
+                    if ((mod & KMOD_CTRL) && sc == SDL_SCANCODE_C) {
+                        if (hasSelection) editor->copy(selRow0, selCol0, selRow1, selCol1);
+                        continue;
+                    }
+                    if ((mod & KMOD_CTRL) && sc == SDL_SCANCODE_V) {
+                        int row = 0, col = 0;
+                        if (editorMouseCell(&row, &col)) editor->paste(row, col);
+                        continue;
+                    }
+                    if (sc == SDL_SCANCODE_TAB) {
+                        editor->endStroke();
+                        dragging = false;
+                        editTool = (editTool + 1) % TOOL_COUNT;
+                        continue;
+                    }
+                    if (sc == SDL_SCANCODE_0) { paintTile = TILE_EMPTY; continue; }
+                    if (sc >= SDL_SCANCODE_1 && sc <= SDL_SCANCODE_3) {
+                        paintTile = static_cast<TileGrid::Tile>(TILE_SOLID + (sc - SDL_SCANCODE_1));
+                        continue;
+                    }
                     if (ev.key.keysym.scancode == SDL_SCANCODE_LEFT) editorCamX -= 32.0f;
                     if (ev.key.keysym.scancode == SDL_SCANCODE_RIGHT) editorCamX += 32.0f;
-                    float maxCam = std::max(0.0f, (float)(level.cols * baseTilePixels) - (float)WINW / renderTileScale);
+                    float maxCam = std::max(0.0f, (float)(level.cols() * baseTilePixels) - (float)WINW / renderTileScale);
                     editorCamX = std::max(0.0f, std::min(editorCamX, maxCam));
                     continue;
                 }
 
-    if (editMode && ev.type == SDL_MOUSEBUTTONDOWN && ev.button.button == SDL_BUTTON_LEFT) {
-        int winMouseX_evt = ev.button.x;
-        int winMouseY_evt = ev.button.y;
-        int winMouseX_state = 0, winMouseY_state = 0;
-        SDL_GetMouseState(&winMouseX_state, &winMouseY_state);
-
-        // Window size in window coordinates
-        int winW_win = 0, winH_win = 0;
-        SDL_GetWindowSize(win, &winW_win, &winH_win);
-        if (winW_win <= 0 || winH_win <= 0) continue;
-
-        // Renderer output size in pixels
-        int outW_pixels = 0, outH_pixels = 0;
-        SDL_GetRendererOutputSize(ren, &outW_pixels, &outH_pixels);
-        if (outW_pixels <= 0 || outH_pixels <= 0) continue;
-
-        // Logical size
-        int logicalW = 0, logicalH = 0;
-        SDL_RenderGetLogicalSize(ren, &logicalW, &logicalH);
-        if (logicalW <= 0 || logicalH <= 0) continue;
-
-        float lx = static_cast<float>(winMouseX_state) * static_cast<float>(logicalW) / static_cast<float>(winW_win);
-        float ly = static_cast<float>(winMouseY_state) * static_cast<float>(logicalH) / static_cast<float>(winH_win);
-
-        float editorScale = 1.0f / editorTileScale;
-        float mx_editor = lx * editorScale;
-        float my_editor = ly * editorScale;
+                if (editMode && ev.type == SDL_MOUSEBUTTONDOWN && ev.button.button == SDL_BUTTON_LEFT) {
+                    int row = 0, col = 0;
+                    if (!editorMouseCell(&row, &col)) continue;
+                    switch (editTool) {
+                    case TOOL_CYCLE: editor->cycle(row, col); break;
+                    case TOOL_LINE: editor->beginStroke(row, col, paintTile); break;
+                    case TOOL_FLOOD: editor->floodFill(row, col, paintTile); break;
+                    default: // rect and select act on release
+                        dragging = true;
+                        dragRow0 = dragRow1 = row;
+                        dragCol0 = dragCol1 = col;
+                        break;
+                    }
+                    continue;
+                }
 
-        // Compute floating camera offset in editor pixel-space (avoid rounding)
-        float camX_editor_f = camX * editorScale;
+                if (editMode && ev.type == SDL_MOUSEMOTION && (editor->stroking() || dragging)) {
+                    int row = 0, col = 0;
+                    if (!editorMouseCell(&row, &col)) continue;
+                    if (editor->stroking()) editor->strokeTo(row, col);
+                    dragRow1 = row;
+                    dragCol1 = col;
+                    continue;
+                }
 
-        // Pass float logical coordinates to editor for precise mapping
-        editor->handleMouse(mx_editor, my_editor, camX_editor_f);
-        continue;
-            }
+                if (editMode && ev.type == SDL_MOUSEBUTTONUP && ev.button.button == SDL_BUTTON_LEFT) {
+                    editor->endStroke();
+                    if (dragging) {
+                        dragging = false;
+                        if (editTool == TOOL_RECT) {
+                            editor->fillRect(dragRow0, dragCol0, dragRow1, dragCol1, paintTile);
+                        } else if (editTool == TOOL_SELECT) {
+                            hasSelection = true;
+                            selRow0 = dragRow0; selCol0 = dragCol0;
+                            selRow1 = dragRow1; selCol1 = dragCol1;
+                        }
+                    }
+                    continue;
+                }
             }
 
+            profiler.add(PROF_EVENTS, profiler.toMs(SDL_GetPerformanceCounter() - eventsStart));
+
             // frame update & render
             const Uint8* kb = SDL_GetKeyboardState(nullptr);
-            if (!editMode && !playerLost && !playerWon) player.update(dt, kb);
 
             if (editMode) {
                 if (kb[SDL_SCANCODE_LEFT]) editorCamX -= 2000.0f * dt;
                 if (kb[SDL_SCANCODE_RIGHT]) editorCamX += 2000.0f * dt;
-                float maxCam = std::max(0.0f, (float)(level.cols * baseTilePixels) - (float)WINW / renderTileScale);
+                float maxCam = std::max(0.0f, (float)(level.cols() * baseTilePixels) - (float)WINW / renderTileScale);
                 editorCamX = std::max(0.0f, std::min(editorCamX, maxCam));
             }
 
@@ -350,49 +513,43 @@ int main(int argc, char* argv[]) {
             int physCellH = baseTilePixels;
             float renderScale = (float)renderCellW / (float)physCellW;
 
-            int levelW = level.cols * physCellW;
-            int levelH_now = level.rows * physCellH;
+            int levelW = level.cols() * physCellW;
+            int levelH_now = level.rows() * physCellH;
 
             int worldW = std::max(levelW, winW);
             int worldH = std::max(levelH_now, winH);
 
-            if (!editMode && !playerLost && !playerWon) {
-                resolvePlayerCollisions(player, level, physCellW , physCellH);
-
-                // Check for game over conditions
-                if (player.health <= 0) {
-                    playerLost = true;
-                    fade = 0.0f;
-                    running = false;
-                }
-                if (player.x >= levelW - player.width) {
-                    playerWon = true;
-                    running = false;
-                }
+            // Fixed-step simulation: run as many ticks as the elapsed time covers
+            int simSteps = simClock.advance(dt);
+            sim.setPaused(editMode);
+            PlayerInput input = PlayerInput::fromKeyboard(kb);
+            for (int step = 0; step < simSteps; ++step) {
+                sim.tick(input, simClock.tickDt());
+                recorder.tick(input, editMode, sim);
             }
 
-            // clamp player to level bounds (physics units)
-            if (levelW > 0) {
-                if (player.x < 0.f) player.x = 0.f;
-                float maxPlayerX = (float)std::max(0, levelW - player.width);
-                if (player.x > maxPlayerX) player.x = maxPlayerX;
-            }
-            if (levelH_now > 0) {
-                if (player.y < 0.f) player.y = 0.f;
-                float maxPlayerY = (float)std::max(0, levelH_now - player.height);
-                if (player.y > maxPlayerY) { player.y = maxPlayerY; player.onGround = true; player.vy = 0.f; }
+            // Check for game over conditions
+            if (sim.finished() && !playerLost && !playerWon) {
+                playerLost = sim.lost();
+                playerWon = sim.won();
+                fade = 0.0f;
+                running = false;
             }
 
+            // Interpolated player position between the last two ticks
+            float simAlpha = simClock.alpha();
+            float playerX_render = player.renderX(simAlpha);
+
             // Camera: center on player in physics units, clamp to level bounds
-            float camTarget = player.x - ( (float)winW / (2.0f * renderScale) );
+            float camTarget = playerX_render - ( (float)winW / (2.0f * renderScale) );
             float maxCam = std::max(0.0f, (float)(levelW) - (float)winW / renderScale);
             camX = std::max(0.0f, std::min(camTarget, maxCam));
 
-            float levelWorldW = static_cast<float>(level.cols * physCellW);
+            float levelWorldW = static_cast<float>(level.cols() * physCellW);
             float camWidthWorld = static_cast<float>(winW) / renderScale;
             float maxCamWorld = std::max(0.0f, levelWorldW - camWidthWorld);
 
-            float playerCenter = player.x + (player.width * 0.5f);
+            float playerCenter = playerX_render + (player.width * 0.5f);
             float camTargetWorld = playerCenter - (camWidthWorld * 0.5f);
             float camX_world = std::max(0.0f, std::min(maxCamWorld, camTargetWorld));
 
@@ -412,153 +569,132 @@ int main(int argc, char* argv[]) {
             if (camMax_render < 0) camMax_render = 0;
             if (camX_render > camMax_render) camX_render = camMax_render;
 
-            // Pass floating camera values to level background
-            level.setBackgroundOffsetFromCamera(camX_render_f, camMax_render_f, (float)dt);
-            level.updateBackground((float)dt);
-
+            // Stream tile chunks around the camera, one screen of margin either side
+            int viewCols = winW / renderCellW + 1;
+            int firstViewCol = camX_render / renderCellW;
+            level.grid.streamColumns(firstViewCol - viewCols, firstViewCol + 2 * viewCols);
 
             // Clear and draw: background, tiles, player, HUD
             SDL_SetRenderDrawColor(ren, 50, 50, 80, 255);
             SDL_RenderClear(ren);
 
-            // Level background
-            level.renderBackground(ren);
+            {
+                // Level background (floating camera values)
+                FrameProfiler::Scope ps(&profiler, PROF_BACKGROUND);
+                background.setOffsetFromCamera(camX_render_f, camMax_render_f, (float)dt);
+                background.update((float)dt);
+                background.render(ren);
+            }
 
+            {
+                // draw visible tiles using camX_render
+                FrameProfiler::Scope ps(&profiler, PROF_TILES);
+                tileRenderer.render(ren, level, camX_render, winW, winH, renderCellW, renderCellH);
+            }
 
-            // draw tiles using camX_render
-            for (int r = 0; r < level.rows; ++r) {
-                for (int c = 0; c < level.cols; ++c) {
-                    int cell = 0;
-                    if (r >= 0 && r < (int)level.grid.size() && c >= 0 && c < (int)level.grid[r].size()) {
-                        cell = level.grid[r][c];
-                    }
-                    if (cell == 0) continue;
-
-                    int tileX_render = c * renderCellW - camX_render;
-                    int tileY_render = r * renderCellH;
-                    SDL_Rect dst{ tileX_render, tileY_render, renderCellW, renderCellH };
-
-                    switch (cell) {
-                        case 1:
-                            SDL_SetRenderDrawColor(ren, 128, 128, 128, 255);
-                            SDL_RenderFillRect(ren, &dst);
-                            break;
-                        case 2:
-                            SDL_SetRenderDrawColor(ren, 160, 40, 40, 255);
-                            SDL_RenderFillRect(ren, &dst);
-                            break;
-                        case 3:
-                            SDL_SetRenderDrawColor(ren, 200, 200, 60, 255);
-                            SDL_RenderFillRect(ren, &dst);
-                            break;
-                        default:
-                            SDL_SetRenderDrawColor(ren, 100, 100, 100, 255);
-                            SDL_RenderFillRect(ren, &dst);
-                            break;
-                    }
-                }
+            {
+                FrameProfiler::Scope ps(&profiler, PROF_SPRITES);
+                renderActors(ren, sim.actors(), camX_render, 0, renderScale, simAlpha);
+                // render player once using same camX_render
+                player.render(ren, camX_render, 0, renderScale, simAlpha);
             }
 
-            // render player once using same camX_render
-            player.render(ren, camX_render, 0, renderScale);
-
-            // HUD/menu rendering
-            menu.render();
-
-            if (!editMode) {
-                SDL_Color color = {0, 0, 0, 255};
-                std::string scoreText = "Punkty: " + std::to_string(player.score);
-                std::string healthText = "HP: " + std::to_string(player.health);
-
-                SDL_Surface* surf1 = TTF_RenderText_Blended(hudFont, scoreText.c_str(), color);
-                if (surf1) {
-                    SDL_Texture* tex1 = SDL_CreateTextureFromSurface(ren, surf1);
-                    if (tex1) {
-                        int w, h;
-                        SDL_QueryTexture(tex1, nullptr, nullptr, &w, &h);
-                        SDL_Rect dst = {WINW - w - 10, 10, w, h};
-                        SDL_RenderCopy(ren, tex1, nullptr, &dst);
-                        SDL_DestroyTexture(tex1);
-                    }
-                    SDL_FreeSurface(surf1);
-                }
+            {
+                // HUD/menu rendering, end screens and the profiler overlay
+                FrameProfiler::Scope ps(&profiler, PROF_HUD);
+                menu.render();
 
-                SDL_Surface* surf2 = TTF_RenderText_Blended(hudFont, healthText.c_str(), color);
-                if (surf2) {
-                    SDL_Texture* tex2 = SDL_CreateTextureFromSurface(ren, surf2);
-                    if (tex2) {
-                        int w, h;
-                        SDL_QueryTexture(tex2, nullptr, nullptr, &w, &h);
-                        SDL_Rect dst = {10, 10, w, h};
-                        SDL_RenderCopy(ren, tex2, nullptr, &dst);
-                        SDL_DestroyTexture(tex2);
+                if (!editMode) {
+                    if (player.score != shownScore) {
+                        shownScore = player.score;
+                        scoreText.set("Punkty: " + std::to_string(shownScore));
                     }
-                    SDL_FreeSurface(surf2);
+                    if (player.health != shownHealth) {
+                        shownHealth = player.health;
+                        healthText.set("HP: " + std::to_string(shownHealth));
+                    }
+                    scoreText.draw(WINW - scoreText.width() - 10, 10);
+                    healthText.draw(10, 10);
                 }
-            }
 
-            if (editMode) {
-                SDL_Color color = {0, 0, 0, 255};
-                SDL_Surface* surf = TTF_RenderText_Blended(hudFont, "Edytor: strza\u0142ki - ruch, lewy myszki - klocek (cykluje warto\u015Bciami)", color);
-                if (surf) {
-                    SDL_Texture* tex = SDL_CreateTextureFromSurface(ren, surf);
-                    if (tex) {
-                        int w, h;
-                        SDL_QueryTexture(tex, nullptr, nullptr, &w, &h);
-                        SDL_Rect dst = {10, 10, w, h};
-                        SDL_RenderCopy(ren, tex, nullptr, &dst);
-                        SDL_DestroyTexture(tex);
+                if (editMode) {
+                    hudText->draw(editorHint, 10, 10, hudColor);
+                    editorToolText.set(std::string("Narz\u0119dzie: ") + editToolNames[editTool] +
+                                       ", klocek: " + std::to_string(paintTile) +
+                                       ", cofnij: " + std::to_string(editor->undoSteps()) +
+                                       ", pon\u00F3w: " + std::to_string(editor->redoSteps()));
+                    editorToolText.draw(10, 10 + hudText->lineHeight());
+
+                    // rectangle being dragged and the current selection
+                    auto outlineCells = [&](int r0, int c0, int r1, int c1) {
+                        SDL_Rect rc{ std::min(c0, c1) * renderCellW - camX_render, std::min(r0, r1) * renderCellH,
+                                     (std::abs(c1 - c0) + 1) * renderCellW, (std::abs(r1 - r0) + 1) * renderCellH };
+                        SDL_RenderDrawRect(ren, &rc);
+                    };
+                    if (hasSelection) {
+                        SDL_SetRenderDrawColor(ren, 0, 160, 255, 255);
+                        outlineCells(selRow0, selCol0, selRow1, selCol1);
+                    }
+                    if (dragging) {
+                        SDL_SetRenderDrawColor(ren, 255, 255, 0, 255);
+                        outlineCells(dragRow0, dragCol0, dragRow1, dragCol1);
                     }
-                    SDL_FreeSurface(surf);
                 }
-            }
-
-            // Render game over screens
-            if (playerLost) {
-                fade += (float)dt * 200.0f; // fade in
-                if (fade > 255.0f) fade = 255.0f;
 
-                SDL_SetRenderDrawColor(ren, 0, 0, 0, (Uint8)fade);
-                SDL_RenderFillRect(ren, nullptr);
+                LevelSaver::Result saved;
+                while (levelSaver.poll(saved)) {
+                    toastText.set(saved.ok ? "Level saved" : "Level save failed");
+                    toastTimer = 2.0f;
+                }
+                if (toastTimer > 0.0f) {
+                    toastTimer -= (float)dt;
+                    toastText.draw(WINW / 2 - toastText.width() / 2, WINH - toastText.height() - 10);
+                }
 
-                SDL_Color color = {255, 0, 0, 255};
-                SDL_Surface* surf = TTF_RenderText_Blended(hudFont, "Przegra\u0142e\u015B", color);
-                if (surf) {
-                    SDL_Texture* tex = SDL_CreateTextureFromSurface(ren, surf);
-                    if (tex) {
-                        int w, h;
-                        SDL_QueryTexture(tex, nullptr, nullptr, &w, &h);
-                        SDL_Rect dst = {WINW / 2 - w / 2, WINH / 2 - h / 2, w, h};
-                        SDL_RenderCopy(ren, tex, nullptr, &dst);
-                        SDL_DestroyTexture(tex);
-                    }
-                    SDL_FreeSurface(surf);
+                // Render game over screens
+                if (playerLost) {
+                    fade += (float)dt * 200.0f; // fade in
+                    if (fade > 255.0f) fade = 255.0f;
+
+                    SDL_SetRenderDrawColor(ren, 0, 0, 0, (Uint8)fade);
+                    SDL_RenderFillRect(ren, nullptr);
+                    lostText.draw(WINW / 2 - lostText.width() / 2, WINH / 2 - lostText.height() / 2);
+                } else if (playerWon) {
+                    SDL_SetRenderDrawColor(ren, 102, 51, 153, 255);
+                    SDL_RenderFillRect(ren, nullptr);
+                    wonText.draw(WINW / 2 - wonText.width() / 2, WINH / 2 - wonText.height() / 2);
                 }
-            } else if (playerWon) {
-                SDL_SetRenderDrawColor(ren, 102, 51, 153, 255);
-                SDL_RenderFillRect(ren, nullptr);
 
-                SDL_Color color = {255, 215, 0, 255};
-                SDL_Surface* surf = TTF_RenderText_Blended(hudFont, "Wygrałeś", color);
-                if (surf) {
-                    SDL_Texture* tex = SDL_CreateTextureFromSurface(ren, surf);
-                    if (tex) {
-                        int w, h;
-                        SDL_QueryTexture(tex, nullptr, nullptr, &w, &h);
-                        SDL_Rect dst = {WINW / 2 - w / 2, WINH / 2 - h / 2, w, h};
-                        SDL_RenderCopy(ren, tex, nullptr, &dst);
-                        SDL_DestroyTexture(tex);
-                    }
-                    SDL_FreeSurface(surf);
+                profiler.renderOverlay(ren, *debugText, 4, 40);
+                if (profiler.overlayVisible()) {
+                    TextureResidency::Stats ts = textureBudget.stats();
+                    char line[128];
+                    std::snprintf(line, sizeof(line), "tex %.1f/%.0f MB  %d res  %d evicted  %llu reloads",
+                                  ts.residentBytes / (1024.0 * 1024.0), ts.budget / (1024.0 * 1024.0),
+                                  ts.resident, ts.evicted, (unsigned long long)ts.reloads);
+                    debugText->draw(line, 4, WINH - debugText->lineHeight() - 4, SDL_Color{255, 255, 255, 255});
                 }
             }
 
-            SDL_RenderPresent(ren);
-            SDL_Delay(5);
+            {
+                FrameProfiler::Scope ps(&profiler, PROF_PRESENT);
+                SDL_RenderPresent(ren);
+            }
+            textureBudget.endFrame();
+            {
+                FrameProfiler::Scope ps(&profiler, PROF_SLEEP);
+                gamePacer.wait();
+            }
+            profiler.endFrame();
         }
 
+        if (recorder.active()) recorder.finish(recordPath);
+        gamePacer.logStats("game");
+        textureBudget.logStats();
+
         // Wait for enter to return to menu
         bool waiting = true;
+        screenPacer.resync();
         while (waiting) {
             SDL_Event ev;
             while (SDL_PollEvent(&ev)) {
@@ -573,39 +709,15 @@ int main(int argc, char* argv[]) {
             if (playerLost) {
                 SDL_SetRenderDrawColor(ren, 0, 0, 0, 255);
                 SDL_RenderFillRect(ren, nullptr);
-                SDL_Color color = {255, 0, 0, 255};
-                SDL_Surface* surf = TTF_RenderText_Blended(hudFont, "Przegra\u0142e\u015B", color);
-                if (surf) {
-                    SDL_Texture* tex = SDL_CreateTextureFromSurface(ren, surf);
-                    if (tex) {
-                        int w, h;
-                        SDL_QueryTexture(tex, nullptr, nullptr, &w, &h);
-                        SDL_Rect dst = {WINW / 2 - w / 2, WINH / 2 - h / 2, w, h};
-                        SDL_RenderCopy(ren, tex, nullptr, &dst);
-                        SDL_DestroyTexture(tex);
-                    }
-                    SDL_FreeSurface(surf);
-                }
+                lostText.draw(WINW / 2 - lostText.width() / 2, WINH / 2 - lostText.height() / 2);
             } else if (playerWon) {
                 SDL_SetRenderDrawColor(ren, 102, 51, 153, 255);
                 SDL_RenderFillRect(ren, nullptr);
-                SDL_Color color = {255, 215, 0, 255};
-                SDL_Surface* surf = TTF_RenderText_Blended(hudFont, "Wygrałeś", color);
-                if (surf) {
-                    SDL_Texture* tex = SDL_CreateTextureFromSurface(ren, surf);
-                    if (tex) {
-                        int w, h;
-                        SDL_QueryTexture(tex, nullptr, nullptr, &w, &h);
-                        SDL_Rect dst = {WINW / 2 - w / 2, WINH / 2 - h / 2, w, h};
-                        SDL_RenderCopy(ren, tex, nullptr, &dst);
-                        SDL_DestroyTexture(tex);
-                    }
-                    SDL_FreeSurface(surf);
-                }
+                wonText.draw(WINW / 2 - wonText.width() / 2, WINH / 2 - wonText.height() / 2);
             }
 
             SDL_RenderPresent(ren);
-            SDL_Delay(16);
+            screenPacer.wait();
         }
 
         // Cleanup for this level
@@ -613,8 +725,16 @@ int main(int argc, char* argv[]) {
         editor = nullptr;
     }
 
-    // cleanup
-    if(hudFont) TTF_CloseFont(hudFont);
+    // cleanup (text textures/font before the renderer and TTF go away)
+    toastText = CachedText();
+    lostText = CachedText();
+    wonText = CachedText();
+    delete hudText;
+    delete menuText;
+    delete debugText;
+    delete playerAtlas;
+    assets.clear();
+    AssetArchive::unmount(); // after fonts/textures: they may read from the mapping
     SDL_DestroyRenderer(ren);
     SDL_DestroyWindow(win);
     TTF_Quit();
@@ -0,0 +1,122 @@
+// projekcik_pack: packs a directory into a single AssetArchive file.
+// Usage: projekcik_pack <assets dir> <output.pak>
+#include "AssetArchive.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+void putU16(std::vector<uint8_t>& out, uint32_t v) {
+    out.push_back(static_cast<uint8_t>(v & 0xFF));
+    out.push_back(static_cast<uint8_t>((v >> 8) & 0xFF));
+}
+
+void putU32(std::vector<uint8_t>& out, uint32_t v) {
+    putU16(out, v & 0xFFFF);
+    putU16(out, v >> 16);
+}
+
+void putU64(std::vector<uint8_t>& out, uint64_t v) {
+    putU32(out, static_cast<uint32_t>(v & 0xFFFFFFFFu));
+    putU32(out, static_cast<uint32_t>(v >> 32));
+}
+
+size_t alignUp(size_t v) {
+    return (v + AssetArchive::kAlign - 1) & ~(AssetArchive::kAlign - 1);
+}
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::fprintf(stderr, "usage: %s <assets dir> <output.pak>\n", argv[0]);
+        return 2;
+    }
+    fs::path root(argv[1]);
+    std::error_code ec;
+    if (!fs::is_directory(root, ec)) {
+        std::fprintf(stderr, "projekcik_pack: %s is not a directory\n", argv[1]);
+        return 1;
+    }
+
+    struct Item {
+        AssetArchive::Entry entry;
+        std::vector<uint8_t> bytes;
+    };
+    std::vector<Item> items;
+    for (const fs::directory_entry& de : fs::recursive_directory_iterator(root)) {
+        if (!de.is_regular_file()) continue;
+        std::ifstream in(de.path(), std::ios::binary);
+        if (!in) {
+            std::fprintf(stderr, "projekcik_pack: cannot read %s\n", de.path().string().c_str());
+            return 1;
+        }
+        Item it;
+        it.bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        // names use '/' on every platform so lookups match the runtime paths
+        it.entry.name = fs::relative(de.path(), root).generic_string();
+        if (it.entry.name.size() > 0xFFFF) continue;
+        it.entry.nameHash = AssetArchive::hash(it.entry.name.data(), it.entry.name.size());
+        it.entry.size = it.bytes.size();
+        it.entry.dataHash = AssetArchive::hash(it.bytes.data(), it.bytes.size());
+        items.push_back(std::move(it));
+    }
+    // sorted by hash for binary search (name as tie-break keeps output deterministic)
+    std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) {
+        if (a.entry.nameHash != b.entry.nameHash) return a.entry.nameHash < b.entry.nameHash;
+        return a.entry.name < b.entry.name;
+    });
+
+    size_t indexBytes = 0;
+    for (const Item& it : items) indexBytes += 34 + it.entry.name.size();
+    size_t offset = alignUp(AssetArchive::kHeaderBytes + indexBytes);
+    for (Item& it : items) {
+        it.entry.offset = offset;
+        offset = alignUp(offset + it.bytes.size());
+    }
+
+    std::vector<uint8_t> out;
+    out.reserve(offset);
+    putU32(out, AssetArchive::kMagic);
+    putU32(out, AssetArchive::kVersion);
+    putU32(out, static_cast<uint32_t>(items.size()));
+    putU32(out, 0);
+    for (const Item& it : items) {
+        putU64(out, it.entry.nameHash);
+        putU64(out, it.entry.offset);
+        putU64(out, it.entry.size);
+        putU64(out, it.entry.dataHash);
+        putU16(out, static_cast<uint32_t>(it.entry.name.size()));
+        out.insert(out.end(), it.entry.name.begin(), it.entry.name.end());
+    }
+    for (const Item& it : items) {
+        out.resize(static_cast<size_t>(it.entry.offset), 0);
+        out.insert(out.end(), it.bytes.begin(), it.bytes.end());
+    }
+
+    // write to a temp file and rename so a failed pack never leaves a torn archive
+    fs::path outPath(argv[2]);
+    fs::path tmpPath = outPath;
+    tmpPath += ".tmp";
+    {
+        std::ofstream f(tmpPath, std::ios::binary | std::ios::trunc);
+        f.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()));
+        if (!f) {
+            std::fprintf(stderr, "projekcik_pack: cannot write %s\n", tmpPath.string().c_str());
+            return 1;
+        }
+    }
+    fs::rename(tmpPath, outPath, ec);
+    if (ec) {
+        std::fprintf(stderr, "projekcik_pack: cannot rename to %s: %s\n", outPath.string().c_str(), ec.message().c_str());
+        return 1;
+    }
+    std::printf("projekcik_pack: %u files, %u bytes -> %s\n", static_cast<unsigned>(items.size()),
+                static_cast<unsigned>(out.size()), outPath.string().c_str());
+    return 0;
+}